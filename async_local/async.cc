@@ -0,0 +1,574 @@
+/**
+ * In-process implementation of the async module (ecsact/runtime/async.h) that
+ * wraps any core module implementation. Each session owns a registry that is
+ * executed on a dedicated thread at a fixed tick rate.
+ *
+ * `option_data` given to `ecsact_async_start` may be an
+ * @ref ecsact_async_tick_options or NULL for defaults. Unknown `pacing` values
+ * use `ECSACT_ASYNC_PACING_SLEEP`. Requests and streams with indexed field
+ * values or with components and actions unknown to the meta module fail with
+ * `ECSACT_ASYNC_ERR_UNSUPPORTED`.
+ */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+#include "ecsact/runtime/async.h"
+#include "ecsact/runtime/core.h"
+#include "async_local/event_buffer.hh"
+#include "async_local/execution_options_coalescer.hh"
+#include "async_local/execution_options_queue.hh"
+#include "async_local/tick_pacer.hh"
+
+using ecsact::async_local::event_buffer;
+using ecsact::async_local::execution_options_coalescer;
+using ecsact::async_local::execution_options_queue;
+using ecsact::async_local::tick_pacer;
+
+namespace {
+
+/**
+ * Session IDs are indices into a fixed table so looking up a session from any
+ * thread never locks
+ */
+constexpr auto max_sessions = size_t{64};
+
+constexpr auto default_queue_slot_count = size_t{4096};
+
+auto tick_options_from( //
+	const void* option_data,
+	int32_t     option_data_size
+) -> ecsact_async_tick_options {
+	auto options = ecsact_async_tick_options{};
+	auto size = static_cast<size_t>(std::max(option_data_size, 0));
+	if(option_data == nullptr || size < sizeof(uint32_t) * 2) {
+		return options;
+	}
+
+	auto magic = uint32_t{};
+	std::memcpy(&magic, option_data, sizeof(magic));
+	if(magic != ECSACT_ASYNC_TICK_OPTIONS_MAGIC) {
+		return options;
+	}
+
+	std::memcpy(&options, option_data, std::min(size, sizeof(options)));
+	switch(options.pacing) {
+		case ECSACT_ASYNC_PACING_SLEEP:
+		case ECSACT_ASYNC_PACING_SPIN:
+		case ECSACT_ASYNC_PACING_HYBRID:
+			break;
+		default:
+			options.pacing = ECSACT_ASYNC_PACING_SLEEP;
+			break;
+	}
+	return options;
+}
+
+class session {
+public:
+	session(
+		ecsact_async_session_id          id,
+		const ecsact_async_tick_options& tick_options
+	)
+		: _id(id)
+		, _pacer(tick_options)
+		, _requests(queue_options(tick_options, {}))
+		, _streams(queue_options(tick_options, _requests.composite_sizes()))
+		, _coalescer(_requests.composite_sizes())
+		, _events(
+				_requests.composite_sizes(),
+				tick_options.coalesce_update_events != 0
+			) {
+		_registry_id = ecsact_create_registry("async_local");
+		_session_events.push_back(ECSACT_ASYNC_SESSION_START);
+		_thread = std::thread([this] { tick_loop(); });
+	}
+
+	~session() {
+		stop();
+	}
+
+	auto stop() -> void {
+		if(_stopping.exchange(true)) {
+			return;
+		}
+
+		_pacer.stop();
+		_thread.join();
+
+		// Requests pushed by enqueue calls that raced with stop are drained too
+		while(_enqueueing.load() != 0) {
+			std::this_thread::yield();
+		}
+		_requests.consume([this](ecsact_async_request_id request_id, auto&) {
+			report_error(ECSACT_ASYNC_ERR_NOT_CONNECTED, request_id);
+		});
+
+		ecsact_destroy_registry(_registry_id);
+
+		auto lk = std::scoped_lock{_mutex};
+		_session_events.push_back(ECSACT_ASYNC_SESSION_STOPPED);
+	}
+
+	auto stopped() const noexcept -> bool {
+		return _stopping.load(std::memory_order_acquire);
+	}
+
+	auto current_tick() const noexcept -> int32_t {
+		return _current_tick.load(std::memory_order_relaxed);
+	}
+
+	auto set_coalesce_policy(ecsact_async_coalesce_policy policy) -> void {
+		_coalesce_policy.store(policy, std::memory_order_relaxed);
+	}
+
+	auto enqueue(const ecsact_execution_options& options)
+		-> ecsact_async_request_id {
+		// Sequentially consistent with stop() so every push either happens before
+		// stop drains the queue or sees the session stopped
+		_enqueueing.fetch_add(1);
+		if(_stopping.load()) {
+			_enqueueing.fetch_sub(1);
+			auto request_id = _requests.reserve_request_id();
+			report_error(ECSACT_ASYNC_ERR_NOT_CONNECTED, request_id);
+			return request_id;
+		}
+
+		auto result = _requests.push(options);
+		_enqueueing.fetch_sub(1);
+		if(result.error != ECSACT_ASYNC_OK) {
+			report_error(result.error, result.request_id);
+		}
+		return result.request_id;
+	}
+
+	auto stream(
+		ecsact_entity_id    entity,
+		ecsact_component_id component_id,
+		const void*         component_data,
+		const void*         indexed_field_values
+	) -> void {
+		if(indexed_field_values != nullptr) {
+			report_error(ECSACT_ASYNC_ERR_UNSUPPORTED, std::nullopt);
+			return;
+		}
+
+		auto component = ecsact_component{component_id, component_data};
+		auto options = ecsact_execution_options{};
+		options.update_components_length = 1;
+		options.update_components_entities = &entity;
+		options.update_components = &component;
+
+		// Streams reuse the execution options queue as single update options
+		auto result = _streams.push(options);
+		if(result.error != ECSACT_ASYNC_OK) {
+			report_error(result.error, std::nullopt);
+		}
+	}
+
+	/**
+	 * Returns `true` if the session is stopped and every event including the
+	 * stop event has been flushed
+	 */
+	auto flush(
+		const ecsact_execution_events_collector* execution_events,
+		const ecsact_async_events_collector*     async_events
+	) -> bool {
+		_events.flush(execution_events);
+
+		{
+			auto lk = std::scoped_lock{_mutex};
+			_flushing_errors.swap(_errors);
+			_flushing_system_errors.swap(_system_errors);
+			_flushing_done_ids.swap(_done_ids);
+			_flushing_done_lengths.swap(_done_lengths);
+			_flushing_session_events.swap(_session_events);
+		}
+
+		auto fully_stopped = false;
+		for(auto event : _flushing_session_events) {
+			if(event == ECSACT_ASYNC_SESSION_STOPPED) {
+				fully_stopped = true;
+			}
+		}
+
+		if(async_events != nullptr) {
+			deliver(*async_events);
+		}
+
+		_flushing_errors.clear();
+		_flushing_system_errors.clear();
+		_flushing_done_ids.clear();
+		_flushing_done_lengths.clear();
+		_flushing_session_events.clear();
+		return fully_stopped;
+	}
+
+private:
+	struct request_error {
+		ecsact_async_error      error;
+		bool                    has_request_id;
+		ecsact_async_request_id request_id;
+	};
+
+	ecsact_async_session_id   _id;
+	tick_pacer                _pacer;
+	ecsact_registry_id        _registry_id;
+	execution_options_queue   _requests;
+	execution_options_queue   _streams;
+	std::atomic_bool          _stopping = false;
+	std::atomic<int32_t>      _enqueueing = 0;
+	std::atomic<int32_t>      _current_tick = 0;
+	std::thread               _thread;
+
+	std::atomic<ecsact_async_coalesce_policy> _coalesce_policy =
+		ECSACT_ASYNC_COALESCE_DEFAULT;
+
+	// Only used by the tick thread
+	execution_options_coalescer _coalescer;
+	event_buffer                _events;
+
+	// Pending async events guarded by _mutex
+	std::mutex                                _mutex;
+	std::vector<request_error>                _errors;
+	std::vector<ecsact_execute_systems_error> _system_errors;
+	std::vector<ecsact_async_request_id>      _done_ids;
+	std::vector<int>                          _done_lengths;
+	std::vector<ecsact_async_session_event>   _session_events;
+
+	// Only used by the flushing thread
+	std::vector<request_error>                _flushing_errors;
+	std::vector<ecsact_execute_systems_error> _flushing_system_errors;
+	std::vector<ecsact_async_request_id>      _flushing_done_ids;
+	std::vector<int>                          _flushing_done_lengths;
+	std::vector<ecsact_async_session_event>   _flushing_session_events;
+
+	static auto queue_options(
+		const ecsact_async_tick_options&           tick_options,
+		const std::unordered_map<int32_t, size_t>& composite_sizes
+	) -> execution_options_queue::options {
+		auto options = execution_options_queue::options{};
+		options.composite_sizes = composite_sizes;
+		options.slot_count = default_queue_slot_count;
+		if(tick_options.queue_high_water_mark > 0) {
+			options.slot_count = std::max<size_t>(
+				options.slot_count,
+				tick_options.queue_high_water_mark
+			);
+			options.high_water_mark = tick_options.queue_high_water_mark;
+		}
+		return options;
+	}
+
+	auto report_error(
+		ecsact_async_error                     error,
+		std::optional<ecsact_async_request_id> request_id
+	) -> void {
+		auto lk = std::scoped_lock{_mutex};
+		_errors.push_back(request_error{
+			.error = error,
+			.has_request_id = request_id.has_value(),
+			.request_id = request_id.value_or(ecsact_async_request_id{}),
+		});
+	}
+
+	auto tick_loop() -> void {
+		while(!_stopping.load(std::memory_order_acquire)) {
+			auto ticks = _pacer.wait();
+			for(auto i = 0; ticks > i; ++i) {
+				run_tick();
+			}
+		}
+	}
+
+	auto run_tick() -> void {
+		_streams.consume([this](auto, const ecsact_execution_options& options) {
+			ecsact_stream(
+				_registry_id,
+				options.update_components_entities[0],
+				options.update_components[0].component_id,
+				options.update_components[0].component_data,
+				nullptr
+			);
+		});
+
+		auto policy = _coalesce_policy.load(std::memory_order_relaxed);
+		_coalescer.set_dedupe_updates(policy == ECSACT_ASYNC_COALESCE_TICK);
+		_requests.consume_while(
+			[this](ecsact_async_request_id request_id, const auto& options) {
+				// A refused request and every request after it stay queued for the
+				// next tick so each tick executes once without reordering changes
+				return _coalescer.add(request_id, options);
+			}
+		);
+
+		execute_merged();
+		_current_tick.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	auto execute_merged() -> void {
+		auto exec_options = _coalescer.merged();
+		auto evc = _events.collector();
+		auto exec_err =
+			ecsact_execute_systems(_registry_id, 1, &exec_options, &evc);
+		_events.end_tick();
+
+		if(exec_err != ECSACT_EXEC_SYS_OK || !_coalescer.empty()) {
+			auto lk = std::scoped_lock{_mutex};
+			if(exec_err != ECSACT_EXEC_SYS_OK) {
+				_system_errors.push_back(exec_err);
+			}
+
+			if(!_coalescer.empty()) {
+				auto request_ids = _coalescer.request_ids();
+				_done_ids.insert(
+					_done_ids.end(),
+					request_ids.begin(),
+					request_ids.end()
+				);
+				_done_lengths.push_back(static_cast<int>(request_ids.size()));
+			}
+		}
+
+		_coalescer.clear();
+	}
+
+	auto deliver(const ecsact_async_events_collector& async_events) -> void {
+		if(async_events.async_error_callback != nullptr) {
+			for(auto err : _flushing_errors) {
+				async_events.async_error_callback(
+					_id,
+					err.error,
+					err.has_request_id ? 1 : 0,
+					&err.request_id,
+					async_events.async_error_callback_user_data
+				);
+			}
+		}
+
+		if(async_events.system_error_callback != nullptr) {
+			for(auto err : _flushing_system_errors) {
+				async_events.system_error_callback(
+					_id,
+					err,
+					async_events.system_error_callback_user_data
+				);
+			}
+		}
+
+		// Every request merged into a tick is reported in one call
+		if(async_events.async_request_done_callback != nullptr) {
+			auto done_ids = _flushing_done_ids.data();
+			for(auto length : _flushing_done_lengths) {
+				async_events.async_request_done_callback(
+					_id,
+					length,
+					done_ids,
+					async_events.async_request_done_callback_user_data
+				);
+				done_ids += length;
+			}
+		}
+
+		if(async_events.async_session_event_callback != nullptr) {
+			for(auto event : _flushing_session_events) {
+				async_events.async_session_event_callback(
+					_id,
+					event,
+					async_events.async_session_event_callback_user_data
+				);
+			}
+		}
+	}
+};
+
+/**
+ * `pins` counts calls currently using `ptr`. The session is only freed once
+ * it has been unpublished and no call has it pinned.
+ */
+struct session_slot {
+	std::atomic<session*> ptr = nullptr;
+	std::atomic<int32_t>  pins = 0;
+};
+
+std::mutex                                         sessions_mutex;
+std::array<session_slot, max_sessions>             sessions{};
+std::array<std::unique_ptr<session>, max_sessions> owned_sessions;
+
+/**
+ * Keeps a session alive for the duration of an API call
+ */
+class session_ref {
+public:
+	session_ref(ecsact_async_session_id session_id) {
+		auto index = static_cast<size_t>(session_id);
+		if(index >= max_sessions) {
+			return;
+		}
+
+		// Sequentially consistent with erase_session so either the session is
+		// seen unpublished or erase_session waits for this pin
+		_slot = &sessions[index];
+		_slot->pins.fetch_add(1);
+		_session = _slot->ptr.load();
+	}
+
+	session_ref(const session_ref&) = delete;
+
+	~session_ref() {
+		release();
+	}
+
+	auto release() -> void {
+		if(_slot != nullptr) {
+			_slot->pins.fetch_sub(1);
+			_slot = nullptr;
+			_session = nullptr;
+		}
+	}
+
+	explicit operator bool() const noexcept {
+		return _session != nullptr;
+	}
+
+	auto operator->() const noexcept -> session* {
+		return _session;
+	}
+
+private:
+	session_slot* _slot = nullptr;
+	session*      _session = nullptr;
+};
+
+/**
+ * Unpublishes the session and frees it once no call has it pinned. Caller must
+ * hold `sessions_mutex` and must not have the session pinned.
+ */
+auto erase_session(size_t index) -> void {
+	auto& slot = sessions[index];
+	slot.ptr.store(nullptr);
+	while(slot.pins.load() != 0) {
+		std::this_thread::yield();
+	}
+	owned_sessions[index].reset();
+}
+} // namespace
+
+ecsact_async_error ecsact_async_set_coalesce_policy(
+	ecsact_async_session_id      session_id,
+	ecsact_async_coalesce_policy policy
+) {
+	auto s = session_ref{session_id};
+	if(!s || s->stopped()) {
+		return ECSACT_ASYNC_ERR_NOT_CONNECTED;
+	}
+
+	if(policy != ECSACT_ASYNC_COALESCE_DEFAULT &&
+		 policy != ECSACT_ASYNC_COALESCE_TICK) {
+		return ECSACT_ASYNC_ERR_UNSUPPORTED;
+	}
+
+	s->set_coalesce_policy(policy);
+	return ECSACT_ASYNC_OK;
+}
+
+ecsact_async_request_id ecsact_async_enqueue_execution_options(
+	ecsact_async_session_id        session_id,
+	const ecsact_execution_options options
+) {
+	auto s = session_ref{session_id};
+	if(!s) {
+		return static_cast<ecsact_async_request_id>(-1);
+	}
+
+	return s->enqueue(options);
+}
+
+void ecsact_async_flush_events(
+	ecsact_async_session_id                  session_id,
+	const ecsact_execution_events_collector* execution_events,
+	const ecsact_async_events_collector*     async_events
+) {
+	auto s = session_ref{session_id};
+	if(!s) {
+		return;
+	}
+
+	// Stopped sessions are kept until their stop event is flushed
+	if(s->flush(execution_events, async_events)) {
+		s.release();
+		auto lk = std::scoped_lock{sessions_mutex};
+		erase_session(static_cast<size_t>(session_id));
+	}
+}
+
+ecsact_async_session_id ecsact_async_start(
+	const void* option_data,
+	int32_t     option_data_size
+) {
+	auto tick_options = tick_options_from(option_data, option_data_size);
+	auto lk = std::scoped_lock{sessions_mutex};
+	for(size_t index = 0; max_sessions > index; ++index) {
+		if(owned_sessions[index]) {
+			continue;
+		}
+
+		auto id = static_cast<ecsact_async_session_id>(index);
+		owned_sessions[index] = std::make_unique<session>(id, tick_options);
+		sessions[index].ptr.store(owned_sessions[index].get());
+		return id;
+	}
+
+	return static_cast<ecsact_async_session_id>(-1);
+}
+
+void ecsact_async_stop(ecsact_async_session_id session_id) {
+	if(auto s = session_ref{session_id}) {
+		s->stop();
+	}
+}
+
+void ecsact_async_stop_all() {
+	for(size_t index = 0; max_sessions > index; ++index) {
+		if(auto s = session_ref{static_cast<ecsact_async_session_id>(index)}) {
+			s->stop();
+		}
+	}
+}
+
+void ecsact_async_force_reset() {
+	auto lk = std::scoped_lock{sessions_mutex};
+	for(size_t index = 0; max_sessions > index; ++index) {
+		erase_session(index);
+	}
+}
+
+int32_t ecsact_async_get_current_tick(ecsact_async_session_id session_id) {
+	auto s = session_ref{session_id};
+	if(!s) {
+		return 0;
+	}
+
+	return s->current_tick();
+}
+
+void ecsact_async_stream(
+	ecsact_async_session_id session_id,
+	ecsact_entity_id        entity,
+	ecsact_component_id     component_id,
+	const void*             component_data,
+	const void*             indexed_field_values
+) {
+	auto s = session_ref{session_id};
+	if(!s || s->stopped()) {
+		return;
+	}
+
+	s->stream(entity, component_id, component_data, indexed_field_values);
+}
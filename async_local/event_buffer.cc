@@ -0,0 +1,348 @@
+#include "async_local/event_buffer.hh"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+using ecsact::async_local::event_buffer;
+
+namespace {
+/**
+ * Component data copied into an event log is aligned to this
+ */
+constexpr auto data_alignment = size_t{8};
+
+/**
+ * Entries preallocated in the pending index when coalescing updates
+ */
+constexpr auto initial_pending_index_capacity = size_t{1024};
+
+auto update_key(ecsact_entity_id entity, int32_t component_id) -> uint64_t {
+	return (static_cast<uint64_t>(static_cast<uint32_t>(entity)) << 32) |
+		static_cast<uint32_t>(component_id);
+}
+} // namespace
+
+event_buffer::event_buffer(
+	std::unordered_map<int32_t, size_t> composite_sizes,
+	bool                                coalesce_updates
+)
+	: _composite_sizes(std::move(composite_sizes))
+	, _coalesce_updates(coalesce_updates)
+	, _pending_index(coalesce_updates ? initial_pending_index_capacity : 0) {
+}
+
+auto event_buffer::collector() noexcept -> ecsact_execution_events_collector {
+	auto evc = ecsact_execution_events_collector{};
+	evc.init_callback = &event_buffer::component_callback;
+	evc.init_callback_user_data = this;
+	evc.update_callback = &event_buffer::component_callback;
+	evc.update_callback_user_data = this;
+	evc.remove_callback = &event_buffer::component_callback;
+	evc.remove_callback_user_data = this;
+	evc.entity_created_callback = &event_buffer::entity_callback;
+	evc.entity_created_callback_user_data = this;
+	evc.entity_destroyed_callback = &event_buffer::entity_callback;
+	evc.entity_destroyed_callback_user_data = this;
+	return evc;
+}
+
+auto event_buffer::end_tick() -> void {
+	if(_recording.events.empty()) {
+		return;
+	}
+
+	auto lk = std::scoped_lock{_mutex};
+	for(const auto& rec : _recording.events) {
+		auto rec_data = _recording.data.data() + rec.data_offset;
+		if(!_coalesce_updates) {
+			_pending.append(rec, rec_data, rec.data_size);
+			continue;
+		}
+
+		auto key = update_key(rec.entity, rec.id);
+		switch(rec.event) {
+			case ECSACT_EVENT_UPDATE_COMPONENT:
+				if(auto index = can_merge_update(key, rec.entity)) {
+					auto& pending_rec = _pending.events[*index];
+					std::memcpy(
+						_pending.data.data() + pending_rec.data_offset,
+						rec_data,
+						rec.data_size
+					);
+					continue;
+				}
+				[[fallthrough]];
+			case ECSACT_EVENT_INIT_COMPONENT:
+			case ECSACT_EVENT_REMOVE_COMPONENT:
+				// Later updates are not merged across an init or remove since the
+				// latest event for the component is no longer an update
+				_pending_index.assign(
+					key,
+					_pending.append(rec, rec_data, rec.data_size)
+				);
+				continue;
+			case ECSACT_EVENT_DESTROY_ENTITY:
+				_pending_index.assign(
+					update_key(rec.entity, pending_index::destroyed_component),
+					_pending.append(rec, rec_data, rec.data_size)
+				);
+				continue;
+			case ECSACT_EVENT_CREATE_ENTITY:
+				break;
+		}
+
+		_pending.append(rec, rec_data, rec.data_size);
+	}
+
+	_recording.clear();
+}
+
+auto event_buffer::flush(const ecsact_execution_events_collector* evc) -> void {
+	{
+		auto lk = std::scoped_lock{_mutex};
+		std::swap(_pending, _flushing);
+		_pending_index.clear();
+	}
+
+	if(evc == nullptr) {
+		_flushing.clear();
+		return;
+	}
+
+	for(const auto& rec : _flushing.events) {
+		auto data = _flushing.data.data() + rec.data_offset;
+		auto component_id = static_cast<ecsact_component_id>(rec.id);
+		auto placeholder_id = static_cast<ecsact_placeholder_entity_id>(rec.id);
+		switch(rec.event) {
+			case ECSACT_EVENT_INIT_COMPONENT:
+				if(evc->init_callback != nullptr) {
+					evc->init_callback(
+						rec.event,
+						rec.entity,
+						component_id,
+						data,
+						evc->init_callback_user_data
+					);
+				}
+				break;
+			case ECSACT_EVENT_UPDATE_COMPONENT:
+				if(evc->update_callback != nullptr) {
+					evc->update_callback(
+						rec.event,
+						rec.entity,
+						component_id,
+						data,
+						evc->update_callback_user_data
+					);
+				}
+				break;
+			case ECSACT_EVENT_REMOVE_COMPONENT:
+				if(evc->remove_callback != nullptr) {
+					evc->remove_callback(
+						rec.event,
+						rec.entity,
+						component_id,
+						data,
+						evc->remove_callback_user_data
+					);
+				}
+				break;
+			case ECSACT_EVENT_CREATE_ENTITY:
+				if(evc->entity_created_callback != nullptr) {
+					evc->entity_created_callback(
+						rec.event,
+						rec.entity,
+						placeholder_id,
+						evc->entity_created_callback_user_data
+					);
+				}
+				break;
+			case ECSACT_EVENT_DESTROY_ENTITY:
+				if(evc->entity_destroyed_callback != nullptr) {
+					evc->entity_destroyed_callback(
+						rec.event,
+						rec.entity,
+						placeholder_id,
+						evc->entity_destroyed_callback_user_data
+					);
+				}
+				break;
+		}
+	}
+
+	_flushing.clear();
+}
+
+/**
+ * @returns index of the pending update @p key can be merged into. Only the
+ *          latest event for the component is merged into and only if the
+ *          entity was not destroyed after it.
+ */
+auto event_buffer::can_merge_update( //
+	uint64_t         key,
+	ecsact_entity_id entity
+) const -> std::optional<size_t> {
+	auto index = _pending_index.find(key);
+	if(!index || _pending.events[*index].event != ECSACT_EVENT_UPDATE_COMPONENT) {
+		return std::nullopt;
+	}
+
+	auto destroyed_index = _pending_index.find(
+		update_key(entity, pending_index::destroyed_component)
+	);
+	if(destroyed_index && *destroyed_index > *index) {
+		return std::nullopt;
+	}
+
+	return index;
+}
+
+auto event_buffer::record_component(
+	ecsact_event        event,
+	ecsact_entity_id    entity_id,
+	ecsact_component_id component_id,
+	const void*         component_data
+) -> void {
+	auto itr = _composite_sizes.find(static_cast<int32_t>(component_id));
+	if(itr == _composite_sizes.end()) {
+		return;
+	}
+
+	auto size = itr->second;
+	auto rec = event_record{
+		.event = event,
+		.entity = entity_id,
+		.id = static_cast<int32_t>(component_id),
+		.data_offset = 0,
+		.data_size = size,
+	};
+	_recording.append(rec, static_cast<const std::byte*>(component_data), size);
+}
+
+event_buffer::pending_index::pending_index(size_t initial_capacity)
+	: _initial_capacity(std::bit_ceil(std::max<size_t>(initial_capacity, 2))) {
+	_entries.resize(_initial_capacity, entry{0, empty_entry});
+	_mask = _initial_capacity - 1;
+	_used.reserve(_initial_capacity / 2);
+}
+
+auto event_buffer::pending_index::find( //
+	uint64_t key
+) const noexcept -> std::optional<size_t> {
+	for(auto i = slot(key);; i = (i + 1) & _mask) {
+		const auto& e = _entries[i];
+		if(e.event_index == empty_entry) {
+			return std::nullopt;
+		}
+		if(e.key == key) {
+			return e.event_index;
+		}
+	}
+}
+
+auto event_buffer::pending_index::assign( //
+	uint64_t key,
+	size_t   event_index
+) -> void {
+	// Kept at most half full so probe sequences stay short
+	if((_used.size() + 1) * 2 > _entries.size()) {
+		grow();
+	}
+
+	for(auto i = slot(key);; i = (i + 1) & _mask) {
+		auto& e = _entries[i];
+		if(e.event_index == empty_entry) {
+			e = entry{key, event_index};
+			_used.push_back(i);
+			return;
+		}
+		if(e.key == key) {
+			e.event_index = event_index;
+			return;
+		}
+	}
+}
+
+auto event_buffer::pending_index::clear() -> void {
+	// Shrunk to 4 times the cleared entries so the next flush with as many
+	// events fits without growing
+	auto shrunk_capacity =
+		std::max(_initial_capacity, std::bit_ceil(_used.size() * 4));
+	if(shrunk_capacity * 4 <= _entries.size()) {
+		_entries = std::vector<entry>(shrunk_capacity, entry{0, empty_entry});
+		_mask = shrunk_capacity - 1;
+		_used.clear();
+		return;
+	}
+
+	for(auto i : _used) {
+		_entries[i].event_index = empty_entry;
+	}
+	_used.clear();
+}
+
+auto event_buffer::pending_index::slot(uint64_t key) const noexcept -> size_t {
+	// Fibonacci hashing spreads sequential entity IDs across the table
+	return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) & _mask;
+}
+
+auto event_buffer::pending_index::grow() -> void {
+	auto old_entries = std::move(_entries);
+	auto old_used = std::move(_used);
+	_entries.assign(old_entries.size() * 2, entry{0, empty_entry});
+	_mask = _entries.size() - 1;
+	_used.clear();
+	for(auto i : old_used) {
+		assign(old_entries[i].key, old_entries[i].event_index);
+	}
+}
+
+auto event_buffer::event_log::append(
+	event_record     rec,
+	const std::byte* rec_data,
+	size_t           rec_data_size
+) -> size_t {
+	rec.data_offset = (data.size() + data_alignment - 1) & ~(data_alignment - 1);
+	rec.data_size = rec_data_size;
+	data.resize(rec.data_offset + rec_data_size);
+	if(rec_data_size > 0) {
+		std::memcpy(data.data() + rec.data_offset, rec_data, rec_data_size);
+	}
+
+	events.push_back(rec);
+	return events.size() - 1;
+}
+
+auto event_buffer::event_log::clear() noexcept -> void {
+	events.clear();
+	data.clear();
+}
+
+void event_buffer::component_callback(
+	ecsact_event        event,
+	ecsact_entity_id    entity_id,
+	ecsact_component_id component_id,
+	const void*         component_data,
+	void*               callback_user_data
+) {
+	auto self = static_cast<event_buffer*>(callback_user_data);
+	self->record_component(event, entity_id, component_id, component_data);
+}
+
+void event_buffer::entity_callback(
+	ecsact_event                 event,
+	ecsact_entity_id             entity_id,
+	ecsact_placeholder_entity_id placeholder_entity_id,
+	void*                        callback_user_data
+) {
+	auto self = static_cast<event_buffer*>(callback_user_data);
+	auto rec = event_record{
+		.event = event,
+		.entity = entity_id,
+		.id = static_cast<int32_t>(placeholder_entity_id),
+		.data_offset = 0,
+		.data_size = 0,
+	};
+	self->_recording.append(rec, nullptr, 0);
+}
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+#include "ecsact/runtime/common.h"
+
+namespace ecsact::async_local {
+
+/**
+ * Buffers execution events on the thread executing systems so they can be
+ * replayed later on the thread calling `ecsact_async_flush_events`.
+ *
+ * Events of a tick are recorded without locking. At the end of each tick they
+ * are appended to a pending log. @ref flush swaps the pending log with a
+ * second log, then replays that one without holding the lock. Each log keeps
+ * its event records and all component data contiguous, so a flush reads
+ * memory linearly. Logs keep their capacity, so nothing is allocated once
+ * warmed up.
+ *
+ * Events for components missing from the composite sizes are dropped since
+ * their data cannot be copied.
+ */
+class event_buffer {
+public:
+	/**
+	 * @param composite_sizes in-memory size of every component by ID used to
+	 *        copy component data. @see execution_options_queue::composite_sizes
+	 * @param coalesce_updates merge update events for the same entity and
+	 *        component across ticks until the next @ref flush. The merged event
+	 *        is delivered where the first update was, with the latest data.
+	 */
+	event_buffer(
+		std::unordered_map<int32_t, size_t> composite_sizes,
+		bool                                coalesce_updates = false
+	);
+
+	/**
+	 * Collector that records into the current tick. Only use on the thread
+	 * executing systems.
+	 */
+	auto collector() noexcept -> ecsact_execution_events_collector;
+
+	/**
+	 * Finish recording the current tick and make it available to @ref flush
+	 */
+	auto end_tick() -> void;
+
+	/**
+	 * Invoke @p evc with every event from finished ticks in the order they were
+	 * recorded. Must not be called concurrently with itself.
+	 *
+	 * @param evc (Optional) when NULL finished ticks are discarded
+	 */
+	auto flush(const ecsact_execution_events_collector* evc) -> void;
+
+private:
+	struct event_record {
+		ecsact_event     event;
+		ecsact_entity_id entity;
+
+		/**
+		 * Component ID for component events or placeholder ID for entity events
+		 */
+		int32_t id;
+
+		/**
+		 * Offset of the component data in the log `data`
+		 */
+		size_t data_offset;
+		size_t data_size;
+	};
+
+	/**
+	 * Open addressing hash table from entity and component ID to the index of
+	 * the latest event for that component in `_pending`. Destroyed entities use
+	 * @ref destroyed_component as their component ID. Entries are never erased
+	 * individually. @ref clear only resets the slots filled since the last
+	 * clear and the storage is kept so it stops allocating once warmed up.
+	 */
+	class pending_index {
+	public:
+		static constexpr auto destroyed_component = int32_t{-1};
+
+		pending_index(size_t initial_capacity);
+
+		/**
+		 * @returns index of the latest event for @p key or `std::nullopt`
+		 */
+		auto find(uint64_t key) const noexcept -> std::optional<size_t>;
+
+		/**
+		 * Set the latest event for @p key to @p event_index
+		 */
+		auto assign(uint64_t key, size_t event_index) -> void;
+
+		/**
+		 * Forget every entry. A table that grew for a burst of events is shrunk
+		 * back when the entries being cleared use little of it.
+		 */
+		auto clear() -> void;
+
+	private:
+		struct entry {
+			uint64_t key;
+
+			/**
+			 * `empty_entry` when unused
+			 */
+			size_t event_index;
+		};
+
+		static constexpr auto empty_entry = ~size_t{};
+
+		std::vector<entry> _entries;
+		size_t             _mask;
+		size_t             _initial_capacity;
+
+		/**
+		 * Slots filled since the last @ref clear
+		 */
+		std::vector<size_t> _used;
+
+		auto slot(uint64_t key) const noexcept -> size_t;
+		auto grow() -> void;
+	};
+
+	struct event_log {
+		std::vector<event_record> events;
+		std::vector<std::byte>    data;
+
+		auto append(
+			event_record     rec,
+			const std::byte* rec_data,
+			size_t           rec_data_size
+		) -> size_t;
+		auto clear() noexcept -> void;
+	};
+
+	std::unordered_map<int32_t, size_t> _composite_sizes;
+	bool                                _coalesce_updates;
+
+	// Only used by the thread executing systems
+	event_log _recording;
+
+	std::mutex _mutex;
+	event_log  _pending;
+
+	/**
+	 * Latest event in `_pending` by entity and component ID. Only used when
+	 * coalescing updates.
+	 */
+	pending_index _pending_index;
+
+	// Only used by the flushing thread
+	event_log _flushing;
+
+	auto can_merge_update(uint64_t key, ecsact_entity_id entity) const
+		-> std::optional<size_t>;
+	auto record_component(
+		ecsact_event        event,
+		ecsact_entity_id    entity_id,
+		ecsact_component_id component_id,
+		const void*         component_data
+	) -> void;
+
+	static void component_callback(
+		ecsact_event        event,
+		ecsact_entity_id    entity_id,
+		ecsact_component_id component_id,
+		const void*         component_data,
+		void*               callback_user_data
+	);
+
+	static void entity_callback(
+		ecsact_event                 event,
+		ecsact_entity_id             entity_id,
+		ecsact_placeholder_entity_id placeholder_entity_id,
+		void*                        callback_user_data
+	);
+};
+
+} // namespace ecsact::async_local
@@ -0,0 +1,271 @@
+#include "async_local/execution_options_coalescer.hh"
+
+#include <cstring>
+
+using ecsact::async_local::execution_options_coalescer;
+
+namespace {
+/**
+ * Every stored component and action is aligned to this
+ */
+constexpr auto data_alignment = size_t{8};
+
+auto update_key(ecsact_entity_id entity, ecsact_component_id component_id)
+	-> uint64_t {
+	return (static_cast<uint64_t>(static_cast<uint32_t>(entity)) << 32) |
+		static_cast<uint32_t>(component_id);
+}
+} // namespace
+
+execution_options_coalescer::execution_options_coalescer(
+	std::unordered_map<int32_t, size_t> composite_sizes
+)
+	: _composite_sizes(std::move(composite_sizes)) {
+}
+
+auto execution_options_coalescer::add(
+	ecsact_async_request_id         request_id,
+	const ecsact_execution_options& exec_options
+) -> bool {
+	if(!empty() && conflicts(exec_options)) {
+		return false;
+	}
+
+	_request_ids.push_back(request_id);
+
+	for(auto i = 0; exec_options.add_components_length > i; ++i) {
+		auto& comp = exec_options.add_components[i];
+		auto  entity = exec_options.add_components_entities[i];
+		_changed_keys.insert(update_key(entity, comp.component_id));
+		_changed_entities.insert(static_cast<int32_t>(entity));
+		_add_entities.push_back(entity);
+		_add_stored.push_back(
+			store(static_cast<int32_t>(comp.component_id), comp.component_data)
+		);
+	}
+
+	for(auto i = 0; exec_options.update_components_length > i; ++i) {
+		auto& comp = exec_options.update_components[i];
+		auto  entity = exec_options.update_components_entities[i];
+		auto  key = update_key(entity, comp.component_id);
+		auto  itr = _update_index.find(key);
+		_changed_entities.insert(static_cast<int32_t>(entity));
+
+		// Later updates to the same component replace the earlier data in place
+		if(_dedupe_updates && itr != _update_index.end()) {
+			auto& stored = _update_stored[itr->second];
+			std::memcpy(
+				_data.data() + stored.offset,
+				comp.component_data,
+				composite_size(stored.id)
+			);
+			continue;
+		}
+
+		_update_index.emplace(key, _update_entities.size());
+		_update_entities.push_back(entity);
+		_update_stored.push_back(
+			store(static_cast<int32_t>(comp.component_id), comp.component_data)
+		);
+	}
+
+	for(auto i = 0; exec_options.remove_components_length > i; ++i) {
+		auto entity = exec_options.remove_components_entities[i];
+		auto component_id = exec_options.remove_components[i];
+		_changed_keys.insert(update_key(entity, component_id));
+		_changed_entities.insert(static_cast<int32_t>(entity));
+		_remove_entities.push_back(entity);
+		_remove_components.push_back(component_id);
+	}
+
+	for(auto i = 0; exec_options.actions_length > i; ++i) {
+		auto& action = exec_options.actions[i];
+		_actions_stored.push_back(
+			store(static_cast<int32_t>(action.action_id), action.action_data)
+		);
+	}
+
+	for(auto i = 0; exec_options.create_entities_length > i; ++i) {
+		auto components_length = exec_options.create_entities_components_length[i];
+		_create_entities.push_back(exec_options.create_entities[i]);
+		_create_components_length.push_back(components_length);
+		for(auto c = 0; components_length > c; ++c) {
+			auto& comp = exec_options.create_entities_components[i][c];
+			_create_stored.push_back(
+				store(static_cast<int32_t>(comp.component_id), comp.component_data)
+			);
+		}
+	}
+
+	for(auto i = 0; exec_options.destroy_entities_length > i; ++i) {
+		auto entity = exec_options.destroy_entities[i];
+		_destroyed_entities.insert(static_cast<int32_t>(entity));
+		_destroy_entities.push_back(entity);
+	}
+
+	return true;
+}
+
+auto execution_options_coalescer::conflicts( //
+	const ecsact_execution_options& exec_options
+) const -> bool {
+	auto destroyed = [&](ecsact_entity_id entity) {
+		return _destroyed_entities.contains(static_cast<int32_t>(entity));
+	};
+
+	auto changed = [&](ecsact_entity_id entity, ecsact_component_id id) {
+		auto key = update_key(entity, id);
+		return _changed_keys.contains(key) || _update_index.contains(key);
+	};
+
+	for(auto i = 0; exec_options.add_components_length > i; ++i) {
+		auto entity = exec_options.add_components_entities[i];
+		auto component_id = exec_options.add_components[i].component_id;
+		if(destroyed(entity) || changed(entity, component_id)) {
+			return true;
+		}
+	}
+
+	for(auto i = 0; exec_options.update_components_length > i; ++i) {
+		auto entity = exec_options.update_components_entities[i];
+		auto component_id = exec_options.update_components[i].component_id;
+		auto key = update_key(entity, component_id);
+		if(destroyed(entity) || _changed_keys.contains(key)) {
+			return true;
+		}
+		if(!_dedupe_updates && _update_index.contains(key)) {
+			return true;
+		}
+	}
+
+	for(auto i = 0; exec_options.remove_components_length > i; ++i) {
+		auto entity = exec_options.remove_components_entities[i];
+		auto component_id = exec_options.remove_components[i];
+		if(destroyed(entity) || changed(entity, component_id)) {
+			return true;
+		}
+	}
+
+	for(auto i = 0; exec_options.destroy_entities_length > i; ++i) {
+		auto entity = static_cast<int32_t>(exec_options.destroy_entities[i]);
+		if(_destroyed_entities.contains(entity) ||
+			 _changed_entities.contains(entity)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+auto execution_options_coalescer::set_dedupe_updates( //
+	bool dedupe_updates
+) noexcept -> void {
+	_dedupe_updates = dedupe_updates;
+}
+
+auto execution_options_coalescer::empty() const noexcept -> bool {
+	return _request_ids.empty();
+}
+
+auto execution_options_coalescer::request_ids() const noexcept
+	-> std::span<const ecsact_async_request_id> {
+	return _request_ids;
+}
+
+auto execution_options_coalescer::merged() -> ecsact_execution_options {
+	to_components(_add_stored, _add_components);
+	to_components(_update_stored, _update_components);
+	to_components(_create_stored, _create_components);
+
+	_actions.resize(_actions_stored.size());
+	for(size_t i = 0; _actions.size() > i; ++i) {
+		_actions[i] = ecsact_action{
+			.action_id = static_cast<ecsact_action_id>(_actions_stored[i].id),
+			.action_data = _data.data() + _actions_stored[i].offset,
+		};
+	}
+
+	_create_components_lists.resize(_create_entities.size());
+	auto create_components_data = _create_components.data();
+	for(size_t i = 0; _create_entities.size() > i; ++i) {
+		_create_components_lists[i] = create_components_data;
+		create_components_data += _create_components_length[i];
+	}
+
+	auto exec_options = ecsact_execution_options{};
+	exec_options.add_components_length = static_cast<int>(_add_entities.size());
+	exec_options.add_components_entities = _add_entities.data();
+	exec_options.add_components = _add_components.data();
+	exec_options.update_components_length =
+		static_cast<int>(_update_entities.size());
+	exec_options.update_components_entities = _update_entities.data();
+	exec_options.update_components = _update_components.data();
+	exec_options.remove_components_length =
+		static_cast<int>(_remove_entities.size());
+	exec_options.remove_components_entities = _remove_entities.data();
+	exec_options.remove_components = _remove_components.data();
+	exec_options.actions_length = static_cast<int>(_actions.size());
+	exec_options.actions = _actions.data();
+	exec_options.create_entities_length =
+		static_cast<int>(_create_entities.size());
+	exec_options.create_entities = _create_entities.data();
+	exec_options.create_entities_components_length =
+		_create_components_length.data();
+	exec_options.create_entities_components = _create_components_lists.data();
+	exec_options.destroy_entities_length =
+		static_cast<int>(_destroy_entities.size());
+	exec_options.destroy_entities = _destroy_entities.data();
+	return exec_options;
+}
+
+auto execution_options_coalescer::clear() noexcept -> void {
+	_request_ids.clear();
+	_data.clear();
+	_update_index.clear();
+	_changed_keys.clear();
+	_changed_entities.clear();
+	_destroyed_entities.clear();
+	_add_entities.clear();
+	_add_stored.clear();
+	_update_entities.clear();
+	_update_stored.clear();
+	_remove_entities.clear();
+	_remove_components.clear();
+	_actions_stored.clear();
+	_create_entities.clear();
+	_create_components_length.clear();
+	_create_stored.clear();
+	_destroy_entities.clear();
+}
+
+auto execution_options_coalescer::store( //
+	int32_t     id,
+	const void* data
+) -> stored_composite {
+	auto size = composite_size(id);
+	auto offset = (_data.size() + data_alignment - 1) & ~(data_alignment - 1);
+	_data.resize(offset + size);
+	std::memcpy(_data.data() + offset, data, size);
+	return {.id = id, .offset = offset};
+}
+
+auto execution_options_coalescer::to_components(
+	const std::vector<stored_composite>& stored,
+	std::vector<ecsact_component>&       out
+) -> void {
+	out.resize(stored.size());
+	for(size_t i = 0; out.size() > i; ++i) {
+		out[i] = ecsact_component{
+			.component_id = static_cast<ecsact_component_id>(stored[i].id),
+			.component_data = _data.data() + stored[i].offset,
+		};
+	}
+}
+
+auto execution_options_coalescer::composite_size(int32_t id) const -> size_t {
+	auto itr = _composite_sizes.find(id);
+	if(itr == _composite_sizes.end()) {
+		return 0;
+	}
+	return itr->second;
+}
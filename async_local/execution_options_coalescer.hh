@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "ecsact/runtime/common.h"
+
+namespace ecsact::async_local {
+
+/**
+ * Merges execution options from many requests into one
+ * @ref ecsact_execution_options as described by `ECSACT_ASYNC_COALESCE_TICK`.
+ *
+ * Component and action data is copied so the added options may be freed right
+ * after @ref add. Storage is reused after @ref clear so a coalescer used for
+ * every tick stops allocating once warmed up.
+ *
+ * Merging never reorders changes to the same entity and component across
+ * requests. A request that would is refused by @ref add and must go in the
+ * next merged options.
+ *
+ * NOTE: indexed field values are not merged. @ref execution_options_queue
+ *       rejects execution options with them before they reach @ref add.
+ */
+class execution_options_coalescer {
+public:
+	/**
+	 * @param composite_sizes in-memory size of every component and action by
+	 *        composite ID. @see execution_options_queue::composite_sizes
+	 */
+	execution_options_coalescer( //
+		std::unordered_map<int32_t, size_t> composite_sizes
+	);
+
+	/**
+	 * Merge @p exec_options into the pending options. Refused if
+	 * @p exec_options adds or removes a component already changed by an added
+	 * request, updates a component an added request added or removed, or
+	 * changes an entity an added request destroyed (and the reverse). Updates
+	 * to the same component are merged unless @ref set_dedupe_updates is
+	 * `false`, in which case they are refused too.
+	 *
+	 * @returns `false` if @p exec_options was refused and nothing was merged.
+	 *          Never refused when @ref empty.
+	 */
+	auto add(
+		ecsact_async_request_id         request_id,
+		const ecsact_execution_options& exec_options
+	) -> bool;
+
+	/**
+	 * When `false` every update is kept, matching
+	 * `ECSACT_ASYNC_COALESCE_DEFAULT`. Defaults to `true`.
+	 */
+	auto set_dedupe_updates(bool dedupe_updates) noexcept -> void;
+
+	/**
+	 * @returns `true` if nothing has been added since the last @ref clear
+	 */
+	auto empty() const noexcept -> bool;
+
+	/**
+	 * Every request ID added since the last @ref clear in the order they were
+	 * added
+	 */
+	auto request_ids() const noexcept -> std::span<const ecsact_async_request_id>;
+
+	/**
+	 * Merged execution options. Valid until the next @ref add or @ref clear.
+	 */
+	auto merged() -> ecsact_execution_options;
+
+	auto clear() noexcept -> void;
+
+private:
+	struct stored_composite {
+		int32_t id;
+		size_t  offset;
+	};
+
+	std::unordered_map<int32_t, size_t>  _composite_sizes;
+	std::vector<ecsact_async_request_id> _request_ids;
+	std::vector<std::byte>               _data;
+	bool                                 _dedupe_updates = true;
+
+	/**
+	 * Index into the update lists by entity and component ID
+	 */
+	std::unordered_map<uint64_t, size_t> _update_index;
+
+	/**
+	 * Entity and component IDs added or removed
+	 */
+	std::unordered_set<uint64_t> _changed_keys;
+
+	/**
+	 * Entities with any component added, updated or removed
+	 */
+	std::unordered_set<int32_t> _changed_entities;
+	std::unordered_set<int32_t> _destroyed_entities;
+
+	std::vector<ecsact_entity_id>             _add_entities;
+	std::vector<stored_composite>             _add_stored;
+	std::vector<ecsact_entity_id>             _update_entities;
+	std::vector<stored_composite>             _update_stored;
+	std::vector<ecsact_entity_id>             _remove_entities;
+	std::vector<ecsact_component_id>          _remove_components;
+	std::vector<stored_composite>             _actions_stored;
+	std::vector<ecsact_placeholder_entity_id> _create_entities;
+	std::vector<int>                          _create_components_length;
+	std::vector<stored_composite>             _create_stored;
+	std::vector<ecsact_entity_id>             _destroy_entities;
+
+	// Lists handed out by merged() pointing into _data
+	std::vector<ecsact_component>  _add_components;
+	std::vector<ecsact_component>  _update_components;
+	std::vector<ecsact_action>     _actions;
+	std::vector<ecsact_component>  _create_components;
+	std::vector<ecsact_component*> _create_components_lists;
+
+	auto conflicts(const ecsact_execution_options& exec_options) const -> bool;
+	auto store(int32_t id, const void* data) -> stored_composite;
+	auto to_components(
+		const std::vector<stored_composite>& stored,
+		std::vector<ecsact_component>&       out
+	) -> void;
+	auto composite_size(int32_t id) const -> size_t;
+};
+
+} // namespace ecsact::async_local
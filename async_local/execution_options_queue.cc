@@ -0,0 +1,264 @@
+#include "async_local/execution_options_queue.hh"
+
+#include <algorithm>
+#include <cstring>
+#include "ecsact/runtime/meta.hh"
+
+using ecsact::async_local::execution_options_queue;
+
+namespace {
+/**
+ * Every component and action copied into a slab is aligned to this
+ */
+constexpr auto data_alignment = size_t{8};
+
+/**
+ * Bump allocates from a slab. With a null @ref base only the required size is
+ * calculated.
+ */
+struct slab_writer {
+	std::byte* base;
+	size_t     size = 0;
+
+	auto take(size_t bytes, size_t alignment) -> std::byte* {
+		size = (size + alignment - 1) & ~(alignment - 1);
+		auto ptr = base != nullptr ? base + size : nullptr;
+		size += bytes;
+		return ptr;
+	}
+
+	template<typename T>
+	auto copy(const T* in, int32_t count) -> T* {
+		auto out = reinterpret_cast<T*>(take(sizeof(T) * count, alignof(T)));
+		if(out != nullptr && count > 0) {
+			std::memcpy(out, in, sizeof(T) * count);
+		}
+		return out;
+	}
+};
+
+auto sizes_from_meta() -> std::unordered_map<int32_t, size_t> {
+	auto sizes = std::unordered_map<int32_t, size_t>{};
+	for(auto package_id : ecsact::meta::get_package_ids()) {
+		for(auto id : ecsact::meta::get_component_ids(package_id)) {
+			sizes[static_cast<int32_t>(id)] = ecsact::meta::composite_size(id);
+		}
+		for(auto id : ecsact::meta::get_transient_ids(package_id)) {
+			sizes[static_cast<int32_t>(id)] = ecsact::meta::composite_size(id);
+		}
+		for(auto id : ecsact::meta::get_action_ids(package_id)) {
+			sizes[static_cast<int32_t>(id)] = ecsact::meta::composite_size(id);
+		}
+	}
+	return sizes;
+}
+} // namespace
+
+execution_options_queue::execution_options_queue(options opts)
+	: _slab_size((std::max<size_t>(opts.slab_size, 64) + 63) & ~size_t{63})
+	, _high_water_mark(opts.high_water_mark)
+	, _composite_sizes(std::move(opts.composite_sizes))
+	, _slots(opts.slot_count) {
+	if(_composite_sizes.empty()) {
+		_composite_sizes = sizes_from_meta();
+	}
+
+	_slabs = std::make_unique_for_overwrite<std::byte[]>(
+		_slots.capacity() * _slab_size
+	);
+}
+
+auto execution_options_queue::push( //
+	const ecsact_execution_options& exec_options
+) -> push_result {
+	if(exec_options.update_components_indexed_fields != nullptr ||
+		 exec_options.remove_components_indexed_fields != nullptr) {
+		return {ECSACT_ASYNC_ERR_UNSUPPORTED, reserve_request_id()};
+	}
+
+	auto required_size = copy_options(exec_options, nullptr);
+	if(!required_size) {
+		return {ECSACT_ASYNC_ERR_UNSUPPORTED, reserve_request_id()};
+	}
+
+	if(_high_water_mark > 0 && size() >= _high_water_mark) {
+		return {ECSACT_ASYNC_ERR_BACK_PRESSURE, reserve_request_id()};
+	}
+
+	auto request_id = ecsact_async_request_id{};
+	auto pushed = _slots.try_push_with([&](slot& s, size_t slot_index) {
+		if(*required_size > _slab_size) {
+			s.overflow = std::make_unique_for_overwrite<std::byte[]>(*required_size);
+			s.data = s.overflow.get();
+		} else {
+			s.data = _slabs.get() + slot_index * _slab_size;
+		}
+
+		request_id = reserve_request_id();
+		copy_options(exec_options, s.data);
+		s.request_id = request_id;
+	});
+
+	if(!pushed) {
+		return {ECSACT_ASYNC_ERR_BACK_PRESSURE, reserve_request_id()};
+	}
+
+	return {ECSACT_ASYNC_OK, request_id};
+}
+
+auto execution_options_queue::reserve_request_id() noexcept
+	-> ecsact_async_request_id {
+	return static_cast<ecsact_async_request_id>(
+		_next_request_id.fetch_add(1, std::memory_order_relaxed)
+	);
+}
+
+auto execution_options_queue::composite_sizes() const noexcept
+	-> const std::unordered_map<int32_t, size_t>& {
+	return _composite_sizes;
+}
+
+auto execution_options_queue::size() const noexcept -> size_t {
+	return _slots.size();
+}
+
+auto execution_options_queue::composite_size( //
+	int32_t composite_id
+) const -> std::optional<size_t> {
+	auto itr = _composite_sizes.find(composite_id);
+	if(itr == _composite_sizes.end()) {
+		return std::nullopt;
+	}
+	return itr->second;
+}
+
+/**
+ * Copies @p exec_options into @p out with every pointer pointing inside of
+ * @p out. The copied @ref ecsact_execution_options is always at the start.
+ *
+ * @param out (Optional) when null nothing is copied
+ * @returns amount of bytes needed in @p out or `std::nullopt` if a component
+ *          or action size is unknown
+ */
+auto execution_options_queue::copy_options(
+	const ecsact_execution_options& exec_options,
+	std::byte*                      out
+) const -> std::optional<size_t> {
+	auto writer = slab_writer{out};
+	auto copied = writer.copy(&exec_options, 1);
+	auto unknown_id = false;
+
+	auto copy_data = [&](int32_t id, const void* in) -> const void* {
+		auto size = composite_size(id);
+		if(!size) {
+			unknown_id = true;
+			return nullptr;
+		}
+		auto data = writer.take(*size, data_alignment);
+		if(data != nullptr) {
+			std::memcpy(data, in, *size);
+		}
+		return data;
+	};
+
+	auto copy_components = [&](const ecsact_component* in, int32_t count) {
+		auto components = writer.copy(in, count);
+		for(auto i = 0; count > i; ++i) {
+			auto data = copy_data(
+				static_cast<int32_t>(in[i].component_id),
+				in[i].component_data
+			);
+			if(components != nullptr) {
+				components[i].component_data = data;
+			}
+		}
+		return components;
+	};
+
+	auto add_components = copy_components(
+		exec_options.add_components,
+		exec_options.add_components_length
+	);
+	auto add_entities = writer.copy(
+		exec_options.add_components_entities,
+		exec_options.add_components_length
+	);
+
+	auto update_components = copy_components(
+		exec_options.update_components,
+		exec_options.update_components_length
+	);
+	auto update_entities = writer.copy(
+		exec_options.update_components_entities,
+		exec_options.update_components_length
+	);
+
+	auto remove_components = writer.copy(
+		exec_options.remove_components,
+		exec_options.remove_components_length
+	);
+	auto remove_entities = writer.copy(
+		exec_options.remove_components_entities,
+		exec_options.remove_components_length
+	);
+
+	auto actions =
+		writer.copy(exec_options.actions, exec_options.actions_length);
+	for(auto i = 0; exec_options.actions_length > i; ++i) {
+		const auto& action = exec_options.actions[i];
+		auto        data =
+			copy_data(static_cast<int32_t>(action.action_id), action.action_data);
+		if(actions != nullptr) {
+			actions[i].action_data = data;
+		}
+	}
+
+	auto create_entities = writer.copy(
+		exec_options.create_entities,
+		exec_options.create_entities_length
+	);
+	auto create_components_length = writer.copy(
+		exec_options.create_entities_components_length,
+		exec_options.create_entities_length
+	);
+	auto create_components = writer.copy(
+		exec_options.create_entities_components,
+		exec_options.create_entities_length
+	);
+	for(auto i = 0; exec_options.create_entities_length > i; ++i) {
+		auto components = copy_components(
+			exec_options.create_entities_components[i],
+			exec_options.create_entities_components_length[i]
+		);
+		if(create_components != nullptr) {
+			create_components[i] = components;
+		}
+	}
+
+	auto destroy_entities = writer.copy(
+		exec_options.destroy_entities,
+		exec_options.destroy_entities_length
+	);
+
+	if(copied != nullptr) {
+		copied->add_components_entities = add_entities;
+		copied->add_components = add_components;
+		copied->update_components_entities = update_entities;
+		copied->update_components = update_components;
+		copied->update_components_indexed_fields = nullptr;
+		copied->remove_components_entities = remove_entities;
+		copied->remove_components = remove_components;
+		copied->remove_components_indexed_fields = nullptr;
+		copied->actions = actions;
+		copied->create_entities = create_entities;
+		copied->create_entities_components_length = create_components_length;
+		copied->create_entities_components = create_components;
+		copied->destroy_entities = destroy_entities;
+	}
+
+	if(unknown_id) {
+		return std::nullopt;
+	}
+
+	return writer.size;
+}
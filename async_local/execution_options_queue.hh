@@ -0,0 +1,159 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include "ecsact/mpsc_queue.hh"
+#include "ecsact/runtime/async.h"
+#include "ecsact/runtime/common.h"
+
+namespace ecsact::async_local {
+
+/**
+ * Bounded lock-free multi-producer single-consumer queue of execution options.
+ * @see ecsact::bounded_mpsc_queue
+ *
+ * Each slot owns a preallocated slab. Producers deep copy the execution
+ * options, including every list and all component and action data, into the
+ * slab of the slot they claim so @ref push never blocks and never allocates
+ * unless the options do not fit in a slab. The consumer reads the options in
+ * place and the slot is reused once consumed.
+ *
+ * Execution options with indexed field values or with components and actions
+ * missing from @ref composite_sizes are rejected since their data cannot be
+ * copied.
+ */
+class execution_options_queue {
+public:
+	struct options {
+		/**
+		 * Maximum amount of queued execution options. Rounded up to a power of 2.
+		 */
+		size_t slot_count = 1024;
+
+		/**
+		 * Bytes preallocated per slot. Execution options that need more than this
+		 * are copied to a heap allocation instead.
+		 */
+		size_t slab_size = 4096;
+
+		/**
+		 * Queued execution options at which @ref push starts rejecting new ones.
+		 * `0` only rejects when every slot is used.
+		 */
+		size_t high_water_mark = 0;
+
+		/**
+		 * In-memory size of every component and action by composite ID. When
+		 * empty the sizes of every component, transient and action in all loaded
+		 * packages are read with the meta module.
+		 */
+		std::unordered_map<int32_t, size_t> composite_sizes;
+	};
+
+	struct push_result {
+		/**
+		 * `ECSACT_ASYNC_OK` when the execution options were queued.
+		 * `ECSACT_ASYNC_ERR_BACK_PRESSURE` when the queue is full or at its
+		 * high-water mark. `ECSACT_ASYNC_ERR_UNSUPPORTED` when the execution
+		 * options cannot be copied.
+		 */
+		ecsact_async_error error;
+
+		/**
+		 * Assigned even if the execution options were rejected so the error can
+		 * be reported with an ID unique among the queued ones
+		 */
+		ecsact_async_request_id request_id;
+	};
+
+	execution_options_queue(options opts);
+	execution_options_queue(const execution_options_queue&) = delete;
+	execution_options_queue(execution_options_queue&&) = delete;
+
+	/**
+	 * Copy @p exec_options into the queue. Safe to call from any thread.
+	 */
+	auto push(const ecsact_execution_options& exec_options) -> push_result;
+
+	/**
+	 * Reserve a request ID without queueing anything. Used to report errors for
+	 * rejected requests with IDs unique among the ones from @ref push.
+	 */
+	auto reserve_request_id() noexcept -> ecsact_async_request_id;
+
+	/**
+	 * Invoke @p fn with `(ecsact_async_request_id, const
+	 * ecsact_execution_options&)` for every queued execution options in the
+	 * order they were pushed. The execution options are only valid during the
+	 * @p fn call. Must only be called from one thread at a time.
+	 *
+	 * @returns amount of execution options consumed
+	 */
+	template<typename Fn>
+	auto consume(Fn&& fn) -> size_t {
+		return _slots.consume([&](slot& s) {
+			fn(s.request_id,
+				 *reinterpret_cast<const ecsact_execution_options*>(s.data));
+			s.overflow.reset();
+		});
+	}
+
+	/**
+	 * Same as @ref consume but @p fn returns `bool`. Stops at the first
+	 * execution options @p fn returns `false` for. Those stay queued, still
+	 * counting toward the high-water mark, and are the first ones passed to
+	 * @p fn on the next call.
+	 *
+	 * @returns amount of execution options consumed
+	 */
+	template<typename Fn>
+	auto consume_while(Fn&& fn) -> size_t {
+		return _slots.consume_while([&](slot& s) {
+			auto consumed =
+				fn(s.request_id,
+					 *reinterpret_cast<const ecsact_execution_options*>(s.data));
+			if(consumed) {
+				s.overflow.reset();
+			}
+			return consumed;
+		});
+	}
+
+	/**
+	 * In-memory size of every component and action by composite ID used to copy
+	 * component and action data
+	 */
+	auto composite_sizes() const noexcept
+		-> const std::unordered_map<int32_t, size_t>&;
+
+	/**
+	 * Approximate amount of queued execution options
+	 */
+	auto size() const noexcept -> size_t;
+
+private:
+	struct slot {
+		ecsact_async_request_id      request_id;
+		std::byte*                   data;
+		std::unique_ptr<std::byte[]> overflow;
+	};
+
+	size_t                              _slab_size;
+	size_t                              _high_water_mark;
+	std::unordered_map<int32_t, size_t> _composite_sizes;
+	bounded_mpsc_queue<slot>            _slots;
+	std::unique_ptr<std::byte[]>        _slabs;
+	std::atomic<int32_t>                _next_request_id = 0;
+
+	auto composite_size(int32_t composite_id) const -> std::optional<size_t>;
+	auto copy_options(
+		const ecsact_execution_options& exec_options,
+		std::byte*                      out
+	) const -> std::optional<size_t>;
+};
+
+} // namespace ecsact::async_local
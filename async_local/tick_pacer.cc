@@ -0,0 +1,115 @@
+#include "async_local/tick_pacer.hh"
+
+#include <algorithm>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || \
+	defined(_M_IX86)
+#	include <immintrin.h>
+#	define ECSACT_ASYNC_LOCAL_CPU_PAUSE() _mm_pause()
+#elif defined(__aarch64__) || defined(__arm__)
+#	define ECSACT_ASYNC_LOCAL_CPU_PAUSE() __asm__ __volatile__("yield")
+#else
+#	define ECSACT_ASYNC_LOCAL_CPU_PAUSE() std::this_thread::yield()
+#endif
+
+using ecsact::async_local::tick_pacer;
+
+namespace {
+/**
+ * How long before a tick is due ECSACT_ASYNC_PACING_HYBRID stops sleeping and
+ * starts spinning. Roughly the sleep precision of common schedulers.
+ */
+constexpr auto hybrid_spin_duration = std::chrono::milliseconds{2};
+
+auto tick_interval_from_hz( //
+	int32_t tick_rate_hz
+) -> tick_pacer::clock::duration {
+	if(tick_rate_hz <= 0) {
+		tick_rate_hz = tick_pacer::default_tick_rate_hz;
+	}
+
+	return std::chrono::duration_cast<tick_pacer::clock::duration>(
+		std::chrono::duration<double>{1.0 / tick_rate_hz}
+	);
+}
+
+/**
+ * Tells the CPU the thread is busy waiting so it can give the core to a
+ * sibling hyperthread and use less power while spinning
+ */
+auto cpu_relax() -> void {
+	ECSACT_ASYNC_LOCAL_CPU_PAUSE();
+}
+} // namespace
+
+tick_pacer::tick_pacer(const ecsact_async_tick_options& options)
+	: _interval(tick_interval_from_hz(options.tick_rate_hz))
+	, _max_catch_up_ticks(default_max_catch_up_ticks)
+	, _pacing(options.pacing)
+	, _next_tick(clock::now() + _interval) {
+	if(options.max_catch_up_ticks > 0) {
+		_max_catch_up_ticks = options.max_catch_up_ticks;
+	}
+}
+
+auto tick_pacer::wait() -> int32_t {
+	if(!wait_until(_next_tick)) {
+		return 0;
+	}
+
+	auto now = clock::now();
+	auto due_ticks = 1 + (now - _next_tick) / _interval;
+	auto ticks = static_cast<int32_t>(
+		std::min<int64_t>(due_ticks, static_cast<int64_t>(_max_catch_up_ticks))
+	);
+
+	// Skipped ticks are dropped from the schedule entirely so the loop does not
+	// keep trying to catch up to them
+	_skipped_ticks += due_ticks - ticks;
+	_next_tick += _interval * due_ticks;
+	return ticks;
+}
+
+auto tick_pacer::stop() -> void {
+	{
+		auto lk = std::scoped_lock{_stop_mutex};
+		_stop = true;
+	}
+	_stop_cv.notify_all();
+}
+
+auto tick_pacer::skipped_ticks() const noexcept -> int64_t {
+	return _skipped_ticks;
+}
+
+auto tick_pacer::tick_interval() const noexcept -> clock::duration {
+	return _interval;
+}
+
+auto tick_pacer::wait_until(clock::time_point time) -> bool {
+	switch(_pacing) {
+		case ECSACT_ASYNC_PACING_SLEEP:
+			return sleep_until(time);
+		case ECSACT_ASYNC_PACING_HYBRID:
+			if(!sleep_until(time - hybrid_spin_duration)) {
+				return false;
+			}
+			[[fallthrough]];
+		case ECSACT_ASYNC_PACING_SPIN:
+			while(clock::now() < time) {
+				if(_stop.load(std::memory_order_relaxed)) {
+					return false;
+				}
+				cpu_relax();
+			}
+			break;
+	}
+
+	return !_stop.load(std::memory_order_relaxed);
+}
+
+auto tick_pacer::sleep_until(clock::time_point time) -> bool {
+	auto lk = std::unique_lock{_stop_mutex};
+	return !_stop_cv.wait_until(lk, time, [this] { return _stop.load(); });
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include "ecsact/runtime/async.h"
+
+namespace ecsact::async_local {
+
+/**
+ * Paces a fixed rate tick loop as described by @ref ecsact_async_tick_options.
+ *
+ * Ticks are scheduled from the time the pacer was created rather than from
+ * when the previous tick finished so the rate does not drift. When the loop
+ * falls behind at most `max_catch_up_ticks` are run back to back and the rest
+ * are skipped.
+ *
+ * @ref stop may be called from any thread to interrupt @ref wait.
+ */
+class tick_pacer {
+public:
+	using clock = std::chrono::steady_clock;
+
+	/**
+	 * Defaults used for @ref ecsact_async_tick_options fields left `0`
+	 */
+	static constexpr int32_t default_tick_rate_hz = 60;
+	static constexpr int32_t default_max_catch_up_ticks = 4;
+
+	tick_pacer(const ecsact_async_tick_options& options);
+	tick_pacer(const tick_pacer&) = delete;
+
+	/**
+	 * Waits until the next tick is due or @ref stop is called.
+	 *
+	 * @returns amount of ticks to run now. At least `1` unless stopped, then
+	 *          always `0`.
+	 */
+	auto wait() -> int32_t;
+
+	/**
+	 * Wakes up the current @ref wait and makes every later one return right
+	 * away. Safe to call from any thread.
+	 */
+	auto stop() -> void;
+
+	/**
+	 * Total ticks skipped because the loop fell behind by more than
+	 * `max_catch_up_ticks`
+	 */
+	auto skipped_ticks() const noexcept -> int64_t;
+
+	auto tick_interval() const noexcept -> clock::duration;
+
+private:
+	clock::duration     _interval;
+	int32_t             _max_catch_up_ticks;
+	ecsact_async_pacing _pacing;
+	clock::time_point   _next_tick;
+	int64_t             _skipped_ticks = 0;
+
+	std::mutex              _stop_mutex;
+	std::condition_variable _stop_cv;
+	std::atomic_bool        _stop = false;
+
+	/**
+	 * @returns `false` if stopped before @p time
+	 */
+	auto wait_until(clock::time_point time) -> bool;
+	auto sleep_until(clock::time_point time) -> bool;
+};
+
+} // namespace ecsact::async_local
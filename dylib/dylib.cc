@@ -1,5 +1,8 @@
+#include <algorithm>
+#include <array>
 #include <cstring>
 #include <cassert>
+#include <string_view>
 #include <type_traits>
 #include "ecsact/runtime/dylib.h"
 
@@ -19,6 +22,10 @@
 #	include "ecsact/runtime/meta.h"
 #endif
 
+#ifdef ECSACT_PROFILE_API_LOAD_AT_RUNTIME
+#	include "ecsact/runtime/profile.h"
+#endif
+
 #ifdef ECSACT_SERIALIZE_API_LOAD_AT_RUNTIME
 #	include "ecsact/runtime/serialize.h"
 #endif
@@ -41,72 +48,152 @@ FOR_EACH_ECSACT_DYNAMIC_API_FN(ECSACT_DYLIB_UTIL_FN_PTR_DEFN);
 FOR_EACH_ECSACT_META_API_FN(ECSACT_DYLIB_UTIL_FN_PTR_DEFN);
 #endif
 
+#ifdef ECSACT_PROFILE_API_LOAD_AT_RUNTIME
+FOR_EACH_ECSACT_PROFILE_API_FN(ECSACT_DYLIB_UTIL_FN_PTR_DEFN);
+#endif
+
 #ifdef ECSACT_SERIALIZE_API_LOAD_AT_RUNTIME
 FOR_EACH_ECSACT_SERIALIZE_API_FN(ECSACT_DYLIB_UTIL_FN_PTR_DEFN);
 #endif
 
-#define HAS_FN_CHECK(fn_name, target_fn_name) \
-	if(std::strcmp(target_fn_name, #fn_name) == 0) return true
+#define COUNT_FN(fn_name, count) count += 1
 
-#define ASSIGN_FN_IF(fn_name, target_fn_name, fn_ptr)                  \
+#define ADD_FN_ENTRY(fn_name, entries, index)                          \
 	static_assert(                                                       \
 		std::is_pointer_v<decltype(fn_name)>,                              \
 		"Ecsact dylib may only be used for functions available at runtime" \
 	);                                                                   \
-	if(std::strcmp(#fn_name, target_fn_name) == 0) {                     \
-		fn_name = reinterpret_cast<decltype(fn_name)>(fn_ptr);             \
-	}                                                                    \
-	static_assert(true, "macro requires ;")
-
-bool ecsact_dylib_has_fn(const char* fn_name) {
+	entries[index] = fn_entry{                                           \
+		#fn_name,                                                          \
+		+[](ecsact_dylib_fn fn_ptr) {                                      \
+			fn_name = reinterpret_cast<decltype(fn_name)>(fn_ptr);           \
+		},                                                                 \
+	};                                                                   \
+	index += 1
+
+namespace {
+struct fn_entry {
+	std::string_view name;
+	void (*set_fn_addr)(ecsact_dylib_fn);
+};
+
+constexpr auto fn_entries_count = [] {
+	auto count = size_t{};
 #ifdef ECSACT_ASYNC_API_LOAD_AT_RUNTIME
-	FOR_EACH_ECSACT_ASYNC_API_FN(HAS_FN_CHECK, fn_name);
+	FOR_EACH_ECSACT_ASYNC_API_FN(COUNT_FN, count);
 #endif
 
 #ifdef ECSACT_CORE_API_LOAD_AT_RUNTIME
-	FOR_EACH_ECSACT_CORE_API_FN(HAS_FN_CHECK, fn_name);
+	FOR_EACH_ECSACT_CORE_API_FN(COUNT_FN, count);
 #endif
 
 #ifdef ECSACT_DYNAMIC_API_LOAD_AT_RUNTIME
-	FOR_EACH_ECSACT_DYNAMIC_API_FN(HAS_FN_CHECK, fn_name);
+	FOR_EACH_ECSACT_DYNAMIC_API_FN(COUNT_FN, count);
 #endif
 
 #ifdef ECSACT_META_API_LOAD_AT_RUNTIME
-	FOR_EACH_ECSACT_META_API_FN(HAS_FN_CHECK, fn_name);
+	FOR_EACH_ECSACT_META_API_FN(COUNT_FN, count);
 #endif
 
-#ifdef ECSACT_SERIALIZE_API_LOAD_AT_RUNTIME
-	FOR_EACH_ECSACT_SERIALIZE_API_FN(HAS_FN_CHECK, fn_name);
+#ifdef ECSACT_PROFILE_API_LOAD_AT_RUNTIME
+	FOR_EACH_ECSACT_PROFILE_API_FN(COUNT_FN, count);
 #endif
 
-	return false;
-}
+#ifdef ECSACT_SERIALIZE_API_LOAD_AT_RUNTIME
+	FOR_EACH_ECSACT_SERIALIZE_API_FN(COUNT_FN, count);
+#endif
 
-void ecsact_dylib_set_fn_addr(const char* fn_name, void (*fn_ptr)()) {
-#ifndef NDEBUG
-	if(std::strncmp(fn_name, "ecsact_", 7) != 0) {
-		assert(false && "Cannot load non ecsact fn");
-		return;
-	}
-#endif // NDEBUG
+	return count;
+}();
 
+/**
+ * Every settable function sorted by name so lookups are a binary search
+ * instead of comparing against every function name.
+ */
+constexpr auto fn_entries = [] {
+	auto entries = std::array<fn_entry, fn_entries_count>{};
+	[[maybe_unused]] auto index = size_t{};
 #ifdef ECSACT_ASYNC_API_LOAD_AT_RUNTIME
-	FOR_EACH_ECSACT_ASYNC_API_FN(ASSIGN_FN_IF, fn_name, fn_ptr);
+	FOR_EACH_ECSACT_ASYNC_API_FN(ADD_FN_ENTRY, entries, index);
 #endif
 
 #ifdef ECSACT_CORE_API_LOAD_AT_RUNTIME
-	FOR_EACH_ECSACT_CORE_API_FN(ASSIGN_FN_IF, fn_name, fn_ptr);
+	FOR_EACH_ECSACT_CORE_API_FN(ADD_FN_ENTRY, entries, index);
 #endif
 
 #ifdef ECSACT_DYNAMIC_API_LOAD_AT_RUNTIME
-	FOR_EACH_ECSACT_DYNAMIC_API_FN(ASSIGN_FN_IF, fn_name, fn_ptr);
+	FOR_EACH_ECSACT_DYNAMIC_API_FN(ADD_FN_ENTRY, entries, index);
 #endif
 
 #ifdef ECSACT_META_API_LOAD_AT_RUNTIME
-	FOR_EACH_ECSACT_META_API_FN(ASSIGN_FN_IF, fn_name, fn_ptr);
+	FOR_EACH_ECSACT_META_API_FN(ADD_FN_ENTRY, entries, index);
 #endif
 
-#ifdef ECSACT_SERIALIZE_API_LOAD_AT_RUNTIME
-	FOR_EACH_ECSACT_SERIALIZE_API_FN(ASSIGN_FN_IF, fn_name, fn_ptr);
+#ifdef ECSACT_PROFILE_API_LOAD_AT_RUNTIME
+	FOR_EACH_ECSACT_PROFILE_API_FN(ADD_FN_ENTRY, entries, index);
 #endif
+
+#ifdef ECSACT_SERIALIZE_API_LOAD_AT_RUNTIME
+	FOR_EACH_ECSACT_SERIALIZE_API_FN(ADD_FN_ENTRY, entries, index);
+#endif
+
+	std::sort(entries.begin(), entries.end(), [](auto& a, auto& b) {
+		return a.name < b.name;
+	});
+	return entries;
+}();
+
+static_assert(
+	std::adjacent_find(
+		fn_entries.begin(),
+		fn_entries.end(),
+		[](auto& a, auto& b) { return a.name >= b.name; }
+	) == fn_entries.end(),
+	"Runtime API function names must be sorted and unique"
+);
+
+auto find_fn_entry(std::string_view fn_name) -> const fn_entry* {
+	auto itr = std::lower_bound(
+		fn_entries.begin(),
+		fn_entries.end(),
+		fn_name,
+		[](const fn_entry& entry, std::string_view name) {
+			return entry.name < name;
+		}
+	);
+
+	if(itr == fn_entries.end() || itr->name != fn_name) {
+		return nullptr;
+	}
+
+	return &*itr;
+}
+} // namespace
+
+bool ecsact_dylib_has_fn(const char* fn_name) {
+	return find_fn_entry(fn_name) != nullptr;
+}
+
+void ecsact_dylib_set_fn_addr(const char* fn_name, void (*fn_ptr)()) {
+#ifndef NDEBUG
+	if(std::strncmp(fn_name, "ecsact_", 7) != 0) {
+		assert(false && "Cannot load non ecsact fn");
+		return;
+	}
+#endif // NDEBUG
+
+	auto entry = find_fn_entry(fn_name);
+	if(entry != nullptr) {
+		entry->set_fn_addr(fn_ptr);
+	}
+}
+
+void ecsact_dylib_set_fn_addrs(
+	const char* const*     fn_names,
+	const ecsact_dylib_fn* fn_ptrs,
+	int32_t                count
+) {
+	for(auto i = 0; count > i; ++i) {
+		ecsact_dylib_set_fn_addr(fn_names[i], fn_ptrs[i]);
+	}
 }
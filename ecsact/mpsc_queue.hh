@@ -0,0 +1,157 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace ecsact {
+
+/**
+ * Bounded lock-free multi-producer single-consumer queue.
+ *
+ * Every slot carries a sequence number so producers only contend on the
+ * enqueue position and write their claimed slot without holding anything other
+ * producers wait on. Values live in their slot and are reused in place so
+ * nothing is allocated after construction.
+ */
+template<typename T>
+class bounded_mpsc_queue {
+public:
+	/**
+	 * @param capacity maximum amount of queued values. Rounded up to a power of
+	 *        2.
+	 */
+	explicit bounded_mpsc_queue(size_t capacity) {
+		auto slot_count = std::bit_ceil(std::max<size_t>(capacity, 2));
+		_slots = std::make_unique<slot[]>(slot_count);
+		_mask = slot_count - 1;
+		for(size_t i = 0; slot_count > i; ++i) {
+			_slots[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	bounded_mpsc_queue(const bounded_mpsc_queue&) = delete;
+	bounded_mpsc_queue(bounded_mpsc_queue&&) = delete;
+
+	auto capacity() const noexcept -> size_t {
+		return _mask + 1;
+	}
+
+	/**
+	 * Claim a slot and invoke @p write with `(T& value, size_t slot_index)`
+	 * before handing it to the consumer. `slot_index` is below @ref capacity and
+	 * unique among the queued values. Safe to call from any thread.
+	 *
+	 * @returns `false` without invoking @p write if every slot is used
+	 */
+	template<typename Write>
+	auto try_push_with(Write&& write) -> bool {
+		auto pos = _enqueue_pos.load(std::memory_order_relaxed);
+		for(;;) {
+			auto& s = _slots[pos & _mask];
+			auto  seq = s.sequence.load(std::memory_order_acquire);
+			auto  diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+			if(diff == 0) {
+				if(_enqueue_pos.compare_exchange_weak(
+						 pos,
+						 pos + 1,
+						 std::memory_order_relaxed
+					 )) {
+					break;
+				}
+			} else if(diff < 0) {
+				return false;
+			} else {
+				pos = _enqueue_pos.load(std::memory_order_relaxed);
+			}
+		}
+
+		auto& s = _slots[pos & _mask];
+		write(s.value, pos & _mask);
+		s.sequence.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * Copy @p value into the queue. Safe to call from any thread.
+	 *
+	 * @returns `false` if every slot is used
+	 */
+	auto try_push(const T& value) -> bool {
+		return try_push_with([&](T& slot_value, size_t) { slot_value = value; });
+	}
+
+	/**
+	 * Invoke @p fn with `T&` for every queued value in the order they were
+	 * pushed. The slot is reused once @p fn returns. Must only be called from
+	 * one thread at a time.
+	 *
+	 * @returns amount of values consumed
+	 */
+	template<typename Fn>
+	auto consume(Fn&& fn) -> size_t {
+		return consume_while([&](T& value) {
+			fn(value);
+			return true;
+		});
+	}
+
+	/**
+	 * Same as @ref consume but stops at the first value @p fn returns `false`
+	 * for. That value stays queued and is the first value passed to @p fn on
+	 * the next call.
+	 *
+	 * @returns amount of values consumed, not counting the one left queued
+	 */
+	template<typename Fn>
+	auto consume_while(Fn&& fn) -> size_t {
+		auto count = size_t{};
+		auto pos = _dequeue_pos.load(std::memory_order_relaxed);
+		for(;;) {
+			auto& s = _slots[pos & _mask];
+			auto  seq = s.sequence.load(std::memory_order_acquire);
+			if(seq != pos + 1) {
+				return count;
+			}
+
+			if(!fn(s.value)) {
+				return count;
+			}
+
+			s.sequence.store(pos + _mask + 1, std::memory_order_release);
+			pos += 1;
+			count += 1;
+
+			// Only written by the consumer. Atomic so producers can read it in
+			// size().
+			_dequeue_pos.store(pos, std::memory_order_relaxed);
+		}
+	}
+
+	/**
+	 * Approximate amount of queued values. Safe to call from any thread.
+	 */
+	auto size() const noexcept -> size_t {
+		auto enqueue_pos = _enqueue_pos.load(std::memory_order_relaxed);
+		auto dequeue_pos = _dequeue_pos.load(std::memory_order_relaxed);
+		return enqueue_pos > dequeue_pos ? enqueue_pos - dequeue_pos : 0;
+	}
+
+private:
+	struct slot {
+		std::atomic<size_t> sequence;
+		T                   value;
+	};
+
+	std::unique_ptr<slot[]> _slots;
+	size_t                  _mask;
+
+	alignas(64) std::atomic<size_t> _enqueue_pos = 0;
+	alignas(64) std::atomic<size_t> _dequeue_pos = 0;
+};
+
+} // namespace ecsact
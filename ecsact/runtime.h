@@ -9,6 +9,7 @@
 #include "ecsact/runtime/dynamic.h"
 #include "ecsact/runtime/static.h"
 #include "ecsact/runtime/meta.h"
+#include "ecsact/runtime/profile.h"
 #include "ecsact/runtime/serialize.h"
 #include "ecsact/runtime/async.h"
 
@@ -16,6 +17,7 @@
 	FOR_EACH_ECSACT_CORE_API_FN(fn, __VA_ARGS__);      \
 	FOR_EACH_ECSACT_DYNAMIC_API_FN(fn, __VA_ARGS__);   \
 	FOR_EACH_ECSACT_META_API_FN(fn, __VA_ARGS__);      \
+	FOR_EACH_ECSACT_PROFILE_API_FN(fn, __VA_ARGS__);   \
 	FOR_EACH_ECSACT_STATIC_API_FN(fn, __VA_ARGS__);    \
 	FOR_EACH_ECSACT_SERIALIZE_API_FN(fn, __VA_ARGS__); \
 	FOR_EACH_ECSACT_ASYNC_API_FN(fn, __VA_ARGS__)
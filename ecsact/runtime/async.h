@@ -60,6 +60,18 @@ typedef enum {
 	 */
 	ECSACT_ASYNC_ERR_NOT_CONNECTED,
 
+	/**
+	 * The implementation does not support the requested setting
+	 */
+	ECSACT_ASYNC_ERR_UNSUPPORTED,
+
+	/**
+	 * Request was rejected because the session already had
+	 * `queue_high_water_mark` requests waiting to be executed.
+	 * @see ecsact_async_tick_options
+	 */
+	ECSACT_ASYNC_ERR_BACK_PRESSURE,
+
 	/**
 	 * Internal error has occurred
 	 */
@@ -93,6 +105,76 @@ typedef enum {
 	ECSACT_ASYNC_SESSION_START = 2,
 } ecsact_async_session_event;
 
+typedef enum ecsact_async_pacing {
+	/**
+	 * Sleep until the next tick is due. Lowest CPU usage, wakeups are only as
+	 * precise as the OS scheduler.
+	 */
+	ECSACT_ASYNC_PACING_SLEEP = 0,
+
+	/**
+	 * Busy wait until the next tick is due. Most precise, uses a whole core.
+	 */
+	ECSACT_ASYNC_PACING_SPIN = 1,
+
+	/**
+	 * Sleep until shortly before the next tick is due then busy wait
+	 */
+	ECSACT_ASYNC_PACING_HYBRID = 2,
+} ecsact_async_pacing;
+
+/**
+ * Identifies @ref ecsact_async_tick_options passed as `option_data` to
+ * `ecsact_async_start`. 'ECAT' in little endian.
+ */
+#define ECSACT_ASYNC_TICK_OPTIONS_MAGIC 0x54414345u
+
+/**
+ * Standard `option_data` for `ecsact_async_start` controlling how a session
+ * runs its fixed rate tick loop. Implementations that accept other options
+ * should check `magic` first. Any field left `0` uses the implementation
+ * default.
+ */
+typedef struct ecsact_async_tick_options {
+	/**
+	 * Always `ECSACT_ASYNC_TICK_OPTIONS_MAGIC`
+	 */
+	uint32_t magic;
+
+	/**
+	 * `sizeof(ecsact_async_tick_options)` so fields can be added later
+	 */
+	uint32_t struct_size;
+
+	/**
+	 * Ticks per second the session targets
+	 */
+	int32_t tick_rate_hz;
+
+	/**
+	 * When the session falls behind, the most ticks executed back to back
+	 * before waiting again. Ticks further behind are skipped so latency stays
+	 * bounded instead of growing under overload.
+	 */
+	int32_t max_catch_up_ticks;
+
+	/**
+	 * Requests waiting to be executed at which new requests are rejected with
+	 * `ECSACT_ASYNC_ERR_BACK_PRESSURE`
+	 */
+	int32_t queue_high_water_mark;
+
+	ecsact_async_pacing pacing;
+
+	/**
+	 * Non-zero to merge update events for the same entity and component that
+	 * happen between two `ecsact_async_flush_events` calls into one event
+	 * carrying the latest data. Updates are never merged across an init or
+	 * remove of that component or a destroyed entity.
+	 */
+	int32_t coalesce_update_events;
+} ecsact_async_tick_options;
+
 /**
  * When an error occurs due to an async request this callback is invoked.
  *
@@ -195,9 +277,52 @@ typedef struct ecsact_async_events_collector {
 	void* async_session_event_callback_user_data;
 } ecsact_async_events_collector;
 
+typedef enum ecsact_async_coalesce_policy {
+	/**
+	 * Implementation defined. Requests may be merged into a tick separately
+	 * and fail separately with `ECSACT_ASYNC_ERR_EXECUTION_MERGE_FAILURE`.
+	 */
+	ECSACT_ASYNC_COALESCE_DEFAULT = 0,
+
+	/**
+	 * Every request enqueued before a tick starts is merged into a single
+	 * @ref ecsact_execution_options for that tick. Lists are concatenated in
+	 * enqueue order except updates to the same entity and component, where only
+	 * the last enqueued update is kept. A request that adds or removes a
+	 * component already changed earlier in the tick, or changes an entity
+	 * destroyed earlier in the tick, is carried over to the next tick along
+	 * with every request enqueued after it. Changes are never reordered and
+	 * every tick executes once. Carried over requests still count toward
+	 * `queue_high_water_mark`. All request IDs merged into a tick are reported
+	 * in a single `async_request_done_callback` call.
+	 */
+	ECSACT_ASYNC_COALESCE_TICK = 1,
+} ecsact_async_coalesce_policy;
+
+/**
+ * Sets how requests from `ecsact_async_enqueue_execution_options` are merged
+ * into ticks. Takes effect from the next tick.
+ *
+ * @returns `ECSACT_ASYNC_ERR_UNSUPPORTED` if the implementation does not
+ *          support @p policy
+ */
+ECSACT_ASYNC_API_FN(ecsact_async_error, ecsact_async_set_coalesce_policy)
+( //
+	ecsact_async_session_id      session_id,
+	ecsact_async_coalesce_policy policy
+);
+
 /**
  * Enqueues system execution options that will be used during system execution
  * as soon as possible.
+ *
+ * Thread safety: may be called concurrently from any number of threads while
+ * the session is running without external locking. Implementations must not
+ * block on the thread executing systems. @p options and everything it points
+ * to is copied before returning so the caller may reuse that memory
+ * immediately. Options enqueued from a single thread are executed in the order
+ * they were enqueued. There is no ordering between threads.
+ *
  * @param options - the options passed to `ecsact_execute_systems` in the Async
  * module
  * @returns a request ID representing this async request. Later used in @ref
@@ -216,6 +341,16 @@ ECSACT_ASYNC_API_FN(
  * Invokes the various callbacks in `execution_events` and `async_events` that
  * have been pending. If either a system or async error occurs it's treated
  * as a call to ecscact_async_disconnect
+ *
+ * Thread safety: must not be called concurrently for the same session.
+ * Callbacks are invoked on the calling thread.
+ *
+ * Execution events are delivered in the order they occurred, grouped by tick.
+ * Implementations are expected to record events into one buffer while the
+ * events of a previous flush are read from another, swapping the two here so
+ * the thread executing systems is never blocked by callbacks and flushing
+ * does not allocate. Component data passed to callbacks is only valid for the
+ * duration of the callback.
  */
 ECSACT_ASYNC_API_FN(void, ecsact_async_flush_events)
 ( //
@@ -230,7 +365,8 @@ ECSACT_ASYNC_API_FN(void, ecsact_async_flush_events)
  * authentication for a network connection or various settings that affect the
  * simulation. It is recommended that all implementations handle `NULL` as the
  * 'default' options. You should refer to the implementations documentation for
- * what should be passed here.
+ * what should be passed here. Implementations with a local tick loop should
+ * accept @ref ecsact_async_tick_options.
  *
  * @param option_data_size length (in bytes) of @p option_data
  *
@@ -277,6 +413,9 @@ ECSACT_ASYNC_API_FN(int32_t, ecsact_async_get_current_tick)
  * Sends Ecsact stream data to the specified registry. Stream data will be
  * applied on the next ecsact_execute_systems call.
  *
+ * Thread safety: same guarantees as `ecsact_stream`. May be called from any
+ * thread while the session is running.
+ *
  * @param indexed_field_values if the component has indexed fields then those
  * fields must be supplied as a sequential array in declaration order,
  * otherwise may be NULL.
@@ -301,7 +440,8 @@ ECSACT_ASYNC_API_FN(void, ecsact_async_stream)
 		fn(ecsact_async_stop_all, __VA_ARGS__);                  \
 		fn(ecsact_async_force_reset, __VA_ARGS__);               \
 		fn(ecsact_async_get_current_tick, __VA_ARGS__);          \
-		fn(ecsact_async_stream, __VA_ARGS__)
+		fn(ecsact_async_stream, __VA_ARGS__);                    \
+		fn(ecsact_async_set_coalesce_policy, __VA_ARGS__)
 #endif
 
 #endif // ECSACT_RUNTIME_ASYNC_H
@@ -196,6 +196,13 @@ ECSACT_ALWAYS_INLINE auto stop(ecsact_async_session_id id) -> void {
 	return ecsact_async_get_current_tick(id);
 }
 
+ECSACT_ALWAYS_INLINE auto set_coalesce_policy(
+	ecsact_async_session_id      id,
+	ecsact_async_coalesce_policy policy
+) -> ecsact_async_error {
+	return ecsact_async_set_coalesce_policy(id, policy);
+}
+
 [[nodiscard]] ECSACT_ALWAYS_INLINE auto enqueue_execution_options(
 	ecsact_async_session_id          id,
 	ecsact::core::execution_options& options
@@ -296,6 +296,12 @@ typedef enum {
 	 * An invalid or non-stream component ID was passed into the stream.
 	 */
 	ECSACT_STREAM_INVALID_COMPONENT_ID = 1,
+
+	/**
+	 * An invalid field ID was passed into `ecsact_stream_fields` for the given
+	 * component.
+	 */
+	ECSACT_STREAM_INVALID_FIELD_ID = 2,
 } ecsact_stream_error;
 
 typedef enum {
@@ -377,6 +383,26 @@ typedef enum {
 /**
  * System notify settings control when a system is executed. These settings are
  * on a per-component basis.
+ *
+ * @details Change tracking
+ *   Notify settings must be resolvable without inspecting every entity on every
+ *   execution. Implementations track a per-component 'dirty' bit for every
+ *   entity, grouped into fixed size chunks of entities. A chunk is dirty if any
+ *   entity bit in it is set. The bits are set by:
+ *     - `ecsact_add_component` and execution options adds (init)
+ *     - `ecsact_update_component`, execution options updates, `ecsact_stream`
+ *       and `ecsact_system_execution_context_update` (update)
+ *     - `ecsact_remove_component`, execution options removes, entity
+ *       destruction and `ecsact_system_execution_context_remove` (remove)
+ *
+ *   Every notify filtered system keeps the bits it has not yet observed. The
+ *   bits are cleared for a system once that system has executed. A system
+ *   whose notify components have no dirty chunks is skipped entirely, and
+ *   within a dirty chunk only entities with a dirty bit are visited.
+ *
+ *   `ecsact_component_compare_fn_t` (or an equivalent byte comparison) is only
+ *   used for `ECSACT_SYS_NOTIFY_ONCHANGE` and is only invoked on entities that
+ *   have been marked dirty by an update.
  */
 typedef enum {
 	/**
@@ -397,11 +423,15 @@ typedef enum {
 
 	/**
 	 * System executes when the component is updated with a system update call.
+	 * The component does not need to have changed. Only requires the update
+	 * dirty bit, no comparison occurs.
 	 */
 	ECSACT_SYS_NOTIFY_ONUPDATE,
 
 	/**
-	 * System executes when the components fields have changed.
+	 * System executes when the components fields have changed. Only entities
+	 * with the update dirty bit are compared against the value last observed by
+	 * the system.
 	 */
 	ECSACT_SYS_NOTIFY_ONCHANGE,
 
@@ -411,6 +441,25 @@ typedef enum {
 	ECSACT_SYS_NOTIFY_ONREMOVE,
 } ecsact_system_notify_setting;
 
+/**
+ * Parallel execution settings for systems and actions.
+ *
+ * @details Structural changes
+ *   Adds, removes and generates made by a system through the
+ *   `ecsact_system_execution_context_*` functions are never applied
+ *   immediately when the system runs in parallel. Each worker thread records
+ *   them into its own command buffer without locking. Once every entity has
+ *   been processed by the system the buffers are merged at a single sync point
+ *   and applied sorted by entity ID and then by the order the commands were
+ *   recorded for that entity. Generated entities are created after all adds and
+ *   removes, sorted by the entity that generated them. Entity IDs for generated
+ *   entities are assigned in that order.
+ *
+ *   Because the merge order does not depend on which thread processed an
+ *   entity the result, including `ecsact_hash_registry`, is the same for any
+ *   number of threads. Nested systems observe the changes made by their parent
+ *   only after the parent sync point.
+ */
 typedef enum ecsact_parallel_execution {
 	/**
 	 * Let implementation decide parallel execution.
@@ -700,19 +749,28 @@ typedef enum ecsact_component_type {
 	/*
 	 * The component takes in a continuous feed of data. Look at stream toggle to
 	 * see how you can set the component to receive updates from either
-	 * ecsact_stream or systems.
+	 * ecsact_stream or systems. Stream data is double buffered and may be sent
+	 * from any thread. @see ecsact_stream
 	 */
 	ECSACT_COMPONENT_TYPE_STREAM = 1,
 
 	/*
 	 * The component is a stream component (@see ECSACT_COMPONENT_TYPE_STREAM) but
-	 * may be updated overtime instead of all at once.
+	 * may be updated overtime instead of all at once. Individual fields may be
+	 * streamed with `ecsact_stream_fields`.
 	 */
 	ECSACT_COMPONENT_TYPE_LAZY_STREAM = 2,
 
 	/**
 	 * The component only lives during system execution and is automatically
 	 * removed.
+	 *
+	 * Transient storage is scoped to a single `ecsact_execute_systems` call.
+	 * Implementations allocate transient data from a linear arena that is freed
+	 * in bulk when the call returns instead of removing each transient. Adding
+	 * or removing a transient never produces init or remove events and is not
+	 * part of `ecsact_hash_registry`, `ecsact_dump_entities` or change tracking
+	 * for notify settings.
 	 */
 	ECSACT_COMPONENT_TYPE_TRANSIENT = 3
 } ecsact_component_stream;
@@ -752,7 +810,7 @@ typedef struct ecsact_execution_events_collector {
 	 * Invoked after system executions are finished for every component that is
 	 * new. The component_data is the last value given for the component, not the
 	 * first. Invocation happens in the calling thread. `event` will always be
-	 * `ECSACT_EVENT_INIT_COMPONENT`
+	 * `ECSACT_EVENT_INIT_COMPONENT`. Never invoked for transients.
 	 */
 	ecsact_component_event_callback init_callback;
 
@@ -776,7 +834,7 @@ typedef struct ecsact_execution_events_collector {
 	/**
 	 * Invoked after system executions are finished for every removed component.
 	 * Invocation happens in the calling thread. `event` will always be
-	 * `ECSACT_EVENT_REMOVE_COMPONENT`.
+	 * `ECSACT_EVENT_REMOVE_COMPONENT`. Never invoked for transients.
 	 */
 	ecsact_component_event_callback remove_callback;
 
@@ -41,6 +41,41 @@ ECSACT_CORE_API_FN(ecsact_registry_id, ecsact_create_registry)
 	const char* registry_name
 );
 
+/**
+ * Options for `ecsact_create_registry_ex`. Zero initialized options are the
+ * same as calling `ecsact_create_registry`.
+ */
+typedef struct ecsact_registry_options {
+	/**
+	 * Maximum number of threads `ecsact_execute_systems` may use for this
+	 * registry. `0` lets the implementation decide. `1` disables parallel
+	 * execution regardless of `ecsact_parallel_execution` settings.
+	 */
+	int32_t thread_count;
+
+	/**
+	 * When `true` the registry state after `ecsact_execute_systems`, and
+	 * therefore `ecsact_hash_registry`, must be identical for the same inputs
+	 * regardless of @ref thread_count. Implementations that cannot guarantee
+	 * this must fall back to single threaded execution.
+	 */
+	bool deterministic;
+} ecsact_registry_options;
+
+/**
+ * Create a new registry with options.
+ * @param registry_name (Optional) Display name for the registry. Only used for
+ * debugging.
+ * @param options (Optional) registry options. NULL is the same as zero
+ * initialized options.
+ * @return The newly created registry ID.
+ */
+ECSACT_CORE_API_FN(ecsact_registry_id, ecsact_create_registry_ex)
+( //
+	const char*                    registry_name,
+	const ecsact_registry_options* options
+);
+
 /**
  * Effectively calls `ecsact_destroy_entity` on each entity in the registry. The
  * registry ID is invalid after this call.
@@ -299,6 +334,15 @@ ECSACT_CORE_API_FN(ecsact_ees, ecsact_get_entity_execution_status)
  * applied on the next ecsact_execute_systems call. The last set of stream data
  * is always used.
  *
+ * Thread safety: may be called from any number of threads concurrently with
+ * each other and with `ecsact_execute_systems` on the same registry. Calls
+ * must not block on system execution. Implementations keep a front and back
+ * buffer per stream component; writers publish into the back buffer and
+ * `ecsact_execute_systems` atomically swaps the buffers once at the start of
+ * each execution. Data published after the swap is applied on the following
+ * execution. When multiple writers stream the same entity component between
+ * swaps the data is never torn, but which writer wins is unspecified.
+ *
  * @param indexed_field_values if the component has indexed fields then those
  * fields must be supplied as a sequential array in declaration order,
  * otherwise may be NULL.
@@ -312,6 +356,37 @@ ECSACT_CORE_API_FN(ecsact_stream_error, ecsact_stream)
 	const void*         indexed_field_values
 );
 
+/**
+ * Sends a subset of a stream components fields to the specified registry.
+ * Fields that are not listed keep the value last streamed (or the current
+ * component value if nothing has been streamed yet). Partial updates are merged
+ * into the same buffer used by `ecsact_stream` using the offsets given by
+ * `ecsact_meta_field_offset`, so the same thread safety guarantees apply.
+ *
+ * This is primarily intended for `ECSACT_COMPONENT_TYPE_LAZY_STREAM`
+ * components that are large and change a few fields at a time.
+ *
+ * @param field_count length of @p field_ids and @p field_data
+ * @param field_ids list of field IDs being streamed. Listing the same field
+ *        more than once is allowed and the last value is used.
+ * @param field_data list of pointers to field values associated with
+ *        @p field_ids. Each value must match the size of its fields type
+ *        (including its array length.)
+ * @param indexed_field_values if the component has indexed fields then those
+ * fields must be supplied as a sequential array in declaration order,
+ * otherwise may be NULL.
+ */
+ECSACT_CORE_API_FN(ecsact_stream_error, ecsact_stream_fields)
+( //
+	ecsact_registry_id     registry_id,
+	ecsact_entity_id       entity,
+	ecsact_component_id    component_id,
+	int32_t                field_count,
+	const ecsact_field_id* field_ids,
+	const void**           field_data,
+	const void*            indexed_field_values
+);
+
 // # BEGIN FOR_EACH_ECSACT_CORE_API_FN
 #ifdef ECSACT_MSVC_TRADITIONAL
 #	define FOR_EACH_ECSACT_CORE_API_FN(fn, ...) ECSACT_MSVC_TRADITIONAL_ERROR()
@@ -338,7 +413,9 @@ ECSACT_CORE_API_FN(ecsact_stream_error, ecsact_stream)
 		fn(ecsact_remove_component, __VA_ARGS__);            \
 		fn(ecsact_execute_systems, __VA_ARGS__);             \
 		fn(ecsact_get_entity_execution_status, __VA_ARGS__); \
-		fn(ecsact_stream, __VA_ARGS__)
+		fn(ecsact_stream, __VA_ARGS__);                      \
+		fn(ecsact_stream_fields, __VA_ARGS__);               \
+		fn(ecsact_create_registry_ex, __VA_ARGS__)
 #endif
 
 #endif // ECSACT_RUNTIME_CORE_H
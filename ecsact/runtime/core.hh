@@ -591,6 +591,11 @@ public:
 		_owned = true;
 	}
 
+	registry(const char* name, const ecsact_registry_options& options) {
+		_id = ecsact_create_registry_ex(name, &options);
+		_owned = true;
+	}
+
 	explicit registry(ecsact_registry_id existing_registry_id) {
 		_id = existing_registry_id;
 		_owned = false;
@@ -782,6 +787,39 @@ public:
 		}
 	}
 
+	/**
+	 * Send stream data for @tp Component. Safe to call from any thread.
+	 * @see ecsact_stream
+	 */
+	template<typename Component, typename... AssocFields>
+	ECSACT_ALWAYS_INLINE auto stream(
+		ecsact_entity_id entity_id,
+		const Component& component,
+		AssocFields&&... assoc_fields
+	) -> ecsact_stream_error {
+		if constexpr(Component::has_assoc_fields) {
+			static_assert(
+				sizeof...(AssocFields) > 0,
+				"must be called with assoc fields"
+			);
+		}
+
+		if constexpr(sizeof...(AssocFields) > 0) {
+			const void* assoc_field_values[sizeof...(AssocFields)] = {
+				&assoc_fields...,
+			};
+			return ecsact_stream(
+				_id,
+				entity_id,
+				Component::id,
+				&component,
+				assoc_field_values
+			);
+		} else {
+			return ecsact_stream(_id, entity_id, Component::id, &component, nullptr);
+		}
+	}
+
 	ECSACT_ALWAYS_INLINE auto count_entities() const -> int32_t {
 		return ecsact_count_entities(_id);
 	}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <vector>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include "ecsact/runtime/core.h"
+
+namespace ecsact::core {
+
+/**
+ * Result of @ref check_determinism
+ */
+struct determinism_result {
+	/**
+	 * Thread counts that were checked in the order they were run.
+	 */
+	std::vector<int32_t> thread_counts;
+
+	/**
+	 * `hashes[i][n]` is the `ecsact_hash_registry` result for `thread_counts[i]`
+	 * after the execution options at index `n` were executed.
+	 */
+	std::vector<std::vector<uint64_t>> hashes;
+
+	/**
+	 * Index of the first execution where the hashes of any two thread counts
+	 * did not match. Empty if every hash matched.
+	 */
+	std::optional<size_t> first_mismatch_index;
+
+	/**
+	 * First error returned by `ecsact_execute_systems`. The check stops at the
+	 * failing execution so @ref hashes is incomplete when this is not
+	 * `ECSACT_EXEC_SYS_OK`.
+	 */
+	ecsact_execute_systems_error execute_error = ECSACT_EXEC_SYS_OK;
+
+	auto ok() const noexcept -> bool {
+		return execute_error == ECSACT_EXEC_SYS_OK &&
+			!first_mismatch_index.has_value();
+	}
+};
+
+/**
+ * Thread counts used by @ref check_determinism when none are given. Checks
+ * 1, 2, 4 and the hardware concurrency of the current machine.
+ */
+inline auto default_determinism_thread_counts() -> std::vector<int32_t> {
+	auto thread_counts = std::vector<int32_t>{1, 2, 4};
+	auto hw_thread_count =
+		static_cast<int32_t>(std::thread::hardware_concurrency());
+	if(hw_thread_count > 4) {
+		thread_counts.push_back(hw_thread_count);
+	}
+	return thread_counts;
+}
+
+/**
+ * Runs the same sequence of execution options on a new deterministic registry
+ * (@see ecsact_registry_options::deterministic) for every thread count and
+ * compares `ecsact_hash_registry` after each execution.
+ *
+ * @param execution_options_list execution options that are executed one at a
+ *        time in order.
+ * @param thread_counts thread counts to check.
+ * @param setup invoked with each new registry before any executions. Use this
+ *        to create the initial entities and components.
+ */
+template<typename Setup>
+	requires(std::is_invocable_v<Setup, ecsact_registry_id>)
+auto check_determinism(
+	std::span<const ecsact_execution_options> execution_options_list,
+	std::span<const int32_t>                  thread_counts,
+	Setup&&                                   setup
+) -> determinism_result {
+	auto result = determinism_result{};
+	result.thread_counts.assign(thread_counts.begin(), thread_counts.end());
+	result.hashes.reserve(thread_counts.size());
+
+	for(auto thread_count : thread_counts) {
+		auto options = ecsact_registry_options{};
+		options.thread_count = thread_count;
+		options.deterministic = true;
+
+		auto  reg_id = ecsact_create_registry_ex("determinism", &options);
+		auto& hashes = result.hashes.emplace_back();
+		hashes.reserve(execution_options_list.size());
+
+		setup(reg_id);
+
+		for(const auto& exec_options : execution_options_list) {
+			result.execute_error =
+				ecsact_execute_systems(reg_id, 1, &exec_options, nullptr);
+			if(result.execute_error != ECSACT_EXEC_SYS_OK) {
+				break;
+			}
+			hashes.push_back(ecsact_hash_registry(reg_id));
+		}
+
+		ecsact_destroy_registry(reg_id);
+		if(result.execute_error != ECSACT_EXEC_SYS_OK) {
+			return result;
+		}
+	}
+
+	for(size_t n = 0; execution_options_list.size() > n; ++n) {
+		for(size_t i = 1; result.hashes.size() > i; ++i) {
+			if(result.hashes[i][n] != result.hashes[0][n]) {
+				result.first_mismatch_index = n;
+				return result;
+			}
+		}
+	}
+
+	return result;
+}
+
+/**
+ * Same as @ref check_determinism but uses
+ * @ref default_determinism_thread_counts.
+ */
+template<typename Setup>
+	requires(std::is_invocable_v<Setup, ecsact_registry_id>)
+auto check_determinism(
+	std::span<const ecsact_execution_options> execution_options_list,
+	Setup&&                                   setup
+) -> determinism_result {
+	auto thread_counts = default_determinism_thread_counts();
+	return check_determinism(
+		execution_options_list,
+		std::span<const int32_t>{thread_counts},
+		std::forward<Setup>(setup)
+	);
+}
+
+} // namespace ecsact::core
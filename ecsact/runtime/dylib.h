@@ -1,6 +1,9 @@
 #ifndef ECSACT_DYLIB_H
 #define ECSACT_DYLIB_H
 
+#include <stdint.h>
+#include <stdbool.h>
+
 #ifndef ECSACT_DYLIB_API
 #	ifdef __cplusplus
 #		ifdef _WIN32
@@ -31,4 +34,20 @@ ECSACT_DYLIB_API void ecsact_dylib_set_fn_addr(
 	void (*fn_ptr)()
 );
 
+/**
+ * Generic function address. Cast to the real function type when assigned.
+ */
+typedef void (*ecsact_dylib_fn)();
+
+/**
+ * Set many runtime API function addresses at once. Equivalent to calling
+ * `ecsact_dylib_set_fn_addr` for each name. Names that are not settable are
+ * ignored.
+ */
+ECSACT_DYLIB_API void ecsact_dylib_set_fn_addrs(
+	const char* const*     fn_names,
+	const ecsact_dylib_fn* fn_ptrs,
+	int32_t                count
+);
+
 #endif // ECSACT_DYLIB_H
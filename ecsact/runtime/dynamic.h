@@ -46,6 +46,8 @@ ECSACT_DYNAMIC_API_FN(void, ecsact_system_execution_context_action)
 
 /**
  * Add new component to the entity currently being processed by the system.
+ * The add is deferred until the system sync point when running in parallel.
+ * @see ecsact_parallel_execution
  *
  * Only available if has one of these capabilities:
  *  - `ECSACT_SYS_CAP_ADDS`
@@ -59,7 +61,8 @@ ECSACT_DYNAMIC_API_FN(void, ecsact_system_execution_context_add)
 
 /**
  * Remove existing component from the entity currently being processed by the
- * system.
+ * system. The remove is deferred until the system sync point when running in
+ * parallel. @see ecsact_parallel_execution
  *
  * Only available if has one of these capabilities:
  *  - `ECSACT_SYS_CAP_REMOVES`
@@ -155,7 +158,8 @@ ECSACT_DYNAMIC_API_FN(void, ecsact_system_execution_context_stream_toggle)
 );
 
 /**
- * Generate a new entity with specified components.
+ * Generate a new entity with specified components. The entity is created at the
+ * system sync point. @see ecsact_parallel_execution
  *
  * @param component_count length of `component_ids` and `components_data`
  * @param component_ids list of component ids associated with `components_data`.
@@ -173,6 +177,39 @@ ECSACT_DYNAMIC_API_FN(void, ecsact_system_execution_context_generate)
 	const void**                            components_data
 );
 
+/**
+ * Generate @p entity_count new entities that all have the same set of
+ * components. Instead of copying component data in, the implementation
+ * reserves storage for every generated entity and returns where the data must
+ * be written. This avoids a separate entity creation per generated entity.
+ *
+ * @param entity_count number of entities to generate
+ * @param component_count length of `component_ids` and
+ *        `out_components_data`
+ * @param component_ids list of component ids every generated entity will have
+ * @param out_components_data list written to by the implementation. Each
+ *        element points to `entity_count` sequential component values
+ *        associated with the same index in `component_ids`. The caller must
+ *        write every value before the system execution impl returns. Elements
+ *        for components without any fields are set to NULL.
+ *
+ * Generated entities are created in bulk once the system has finished
+ * executing. `ecsact_execution_events_collector::entity_created_callback` is
+ * invoked sequentially for each of them in generation order with
+ * `ecsact_generated_entity` as the placeholder entity ID.
+ *
+ * @note Only available if the system is a generator. @see
+ * `ecsact_add_system_generate_component_set`
+ */
+ECSACT_DYNAMIC_API_FN(void, ecsact_system_execution_context_generate_batch)
+( //
+	struct ecsact_system_execution_context* context,
+	int32_t                                 entity_count,
+	int32_t                                 component_count,
+	const ecsact_component_id*              component_ids,
+	void**                                  out_components_data
+);
+
 /**
  * Get the parent system execution context.
  *
@@ -334,7 +371,8 @@ ECSACT_DYNAMIC_API_FN(ecsact_component_id, ecsact_create_component)
 );
 
 /**
- * Create new transient
+ * Create new transient. Transient data only lives for the duration of a single
+ * `ecsact_execute_systems` call. @see ECSACT_COMPONENT_TYPE_TRANSIENT
  * @returns unique transient ID for newly created transient
  */
 ECSACT_DYNAMIC_API_FN(ecsact_transient_id, ecsact_create_transient)
@@ -526,6 +564,10 @@ ECSACT_DYNAMIC_API_FN(void, ecsact_set_system_parallel_execution)
 
 /**
  * Set a system component notify setting. Use `ECSACT_SYS_NOTIFY_NONE` to unset.
+ *
+ * Changing a setting resets the systems observed change tracking state. The
+ * next execution treats every entity as dirty for @p component_like_id.
+ * @see ecsact_system_notify_setting
  */
 ECSACT_DYNAMIC_API_FN(void, ecsact_set_system_notify_component_setting)
 ( //
@@ -600,7 +642,8 @@ ECSACT_DYNAMIC_API_FN(void, ecsact_set_component_type)
 		fn(ecsact_set_entity_execution_status, __VA_ARGS__);            \
 		fn(ecsact_set_system_parallel_execution, __VA_ARGS__);          \
 		fn(ecsact_set_system_notify_component_setting, __VA_ARGS__);    \
-		fn(ecsact_set_component_type, __VA_ARGS__)
+		fn(ecsact_set_component_type, __VA_ARGS__);                     \
+		fn(ecsact_system_execution_context_generate_batch, __VA_ARGS__)
 #endif
 
 #endif // ECSACT_RUNTIME_DYNAMIC_H
@@ -519,6 +519,18 @@ ECSACT_META_API_FN(ecsact_component_type, ecsact_meta_component_type)
 	ecsact_component_like_id component_id
 );
 
+/**
+ * Hash of the memory layout of every component, transient, action and enum in
+ * all loaded packages. Two runtimes with the same schema hash store
+ * component and action data identically, so data can be copied between them
+ * without going through each field.
+ *
+ * Only IDs, field types, field offsets, component types and enum values
+ * contribute to the hash. Names do not. Runtimes should return the same value
+ * as the reference `ecsact::meta::compute_schema_hash` in meta.hh.
+ */
+ECSACT_META_API_FN(uint64_t, ecsact_meta_schema_hash)();
+
 // # BEGIN FOR_EACH_ECSACT_META_API_FN
 #ifdef ECSACT_MSVC_TRADITIONAL
 #	define FOR_EACH_ECSACT_META_API_FN(fn, ...) ECSACT_MSVC_TRADITIONAL_ERROR()
@@ -584,7 +596,8 @@ ECSACT_META_API_FN(ecsact_component_type, ecsact_meta_component_type)
 		fn(ecsact_meta_get_system_parallel_execution, __VA_ARGS__);         \
 		fn(ecsact_meta_system_notify_settings_count, __VA_ARGS__);          \
 		fn(ecsact_meta_system_notify_settings, __VA_ARGS__);                \
-		fn(ecsact_meta_component_type, __VA_ARGS__)
+		fn(ecsact_meta_component_type, __VA_ARGS__);                        \
+		fn(ecsact_meta_schema_hash, __VA_ARGS__)
 #endif
 
 #endif // ECSACT_RUNTIME_META_H
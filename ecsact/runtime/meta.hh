@@ -2,6 +2,9 @@
 
 #include <vector>
 #include <string>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
 #include <optional>
 #include <filesystem>
 #include <unordered_map>
@@ -191,6 +194,61 @@ ECSACT_ALWAYS_INLINE auto get_field_type(
 	);
 }
 
+/**
+ * In-memory size of a single value of builtin @p type
+ */
+ECSACT_ALWAYS_INLINE auto builtin_type_size( //
+	ecsact_builtin_type type
+) -> std::size_t {
+	if(type == ECSACT_BOOL) {
+		return 1;
+	}
+
+	// Lower 12 bits are the size in bits. @see ecsact_builtin_type
+	return static_cast<std::size_t>(type & 0xFFF) / 8;
+}
+
+/**
+ * In-memory size of a single element of a field with @p type
+ */
+ECSACT_ALWAYS_INLINE auto field_type_size( //
+	ecsact_field_type type
+) -> std::size_t {
+	while(type.kind == ECSACT_TYPE_KIND_FIELD_INDEX) {
+		type = ecsact_meta_field_type(
+			type.type.field_index.composite_id,
+			type.type.field_index.field_id
+		);
+	}
+
+	if(type.kind == ECSACT_TYPE_KIND_ENUM) {
+		return builtin_type_size(ecsact_meta_enum_storage_type(type.type.enum_id));
+	}
+
+	return builtin_type_size(type.type.builtin);
+}
+
+/**
+ * In-memory size of a component, transient or action calculated from its field
+ * offsets and types. Matches `sizeof` of the generated struct.
+ */
+template<typename CompositeID>
+ECSACT_ALWAYS_INLINE auto composite_size(CompositeID id) -> std::size_t {
+	auto size = std::size_t{};
+	auto alignment = std::size_t{1};
+	auto compo_id = ecsact_id_cast<ecsact_composite_id>(id);
+
+	for(auto field_id : get_field_ids(compo_id)) {
+		auto type = ecsact_meta_field_type(compo_id, field_id);
+		auto offset = ecsact_meta_field_offset(compo_id, field_id);
+		auto type_size = field_type_size(type);
+		alignment = std::max(alignment, type_size);
+		size = std::max(size, offset + type_size * type.length);
+	}
+
+	return (size + alignment - 1) / alignment * alignment;
+}
+
 ECSACT_ALWAYS_INLINE std::vector<ecsact_system_id> get_system_ids(
 	ecsact_package_id package_id
 ) {
@@ -681,4 +739,97 @@ ECSACT_ALWAYS_INLINE auto get_system_parallel_execution( //
 	);
 }
 
+namespace detail {
+struct schema_hasher {
+	/**
+	 * FNV-1a 64-bit offset basis
+	 */
+	std::uint64_t hash = 0xcbf29ce484222325ull;
+
+	template<typename T>
+	ECSACT_ALWAYS_INLINE auto add(T value) -> void {
+		auto bits = static_cast<std::uint64_t>(value);
+		for(auto i = 0; 8 > i; ++i) {
+			hash ^= (bits >> (i * 8)) & 0xFF;
+			hash *= 0x100000001b3ull;
+		}
+	}
+
+	template<typename CompositeID>
+	ECSACT_ALWAYS_INLINE auto add_fields(CompositeID id) -> void {
+		auto field_ids = get_field_ids(id);
+		std::sort(field_ids.begin(), field_ids.end());
+		add(field_ids.size());
+		for(auto field_id : field_ids) {
+			auto composite_id = ecsact_id_cast<ecsact_composite_id>(id);
+			auto field_type = ecsact_meta_field_type(composite_id, field_id);
+			add(field_id);
+			add(field_type.kind);
+			if(field_type.kind == ECSACT_TYPE_KIND_FIELD_INDEX) {
+				add(field_type.type.field_index.composite_id);
+				add(field_type.type.field_index.field_id);
+			} else if(field_type.kind == ECSACT_TYPE_KIND_ENUM) {
+				add(field_type.type.enum_id);
+			} else {
+				add(field_type.type.builtin);
+			}
+			add(field_type.length);
+			add(ecsact_meta_field_offset(composite_id, field_id));
+		}
+	}
+};
+} // namespace detail
+
+/**
+ * Reference implementation of `ecsact_meta_schema_hash` using only the other
+ * meta functions. Packages, declarations, fields and enum values are hashed in
+ * ascending ID order with 64-bit FNV-1a.
+ */
+ECSACT_ALWAYS_INLINE auto compute_schema_hash() -> std::uint64_t {
+	auto hasher = detail::schema_hasher{};
+	auto package_ids = get_package_ids();
+	std::sort(package_ids.begin(), package_ids.end());
+
+	for(auto package_id : package_ids) {
+		auto component_ids = get_component_ids(package_id);
+		std::sort(component_ids.begin(), component_ids.end());
+		for(auto component_id : component_ids) {
+			hasher.add(component_id);
+			hasher.add(ecsact_meta_component_type(
+				ecsact_id_cast<ecsact_component_like_id>(component_id)
+			));
+			hasher.add_fields(component_id);
+		}
+
+		auto transient_ids = get_transient_ids(package_id);
+		std::sort(transient_ids.begin(), transient_ids.end());
+		for(auto transient_id : transient_ids) {
+			hasher.add(transient_id);
+			hasher.add_fields(transient_id);
+		}
+
+		auto action_ids = get_action_ids(package_id);
+		std::sort(action_ids.begin(), action_ids.end());
+		for(auto action_id : action_ids) {
+			hasher.add(action_id);
+			hasher.add_fields(action_id);
+		}
+
+		auto enum_ids = get_enum_ids(package_id);
+		std::sort(enum_ids.begin(), enum_ids.end());
+		for(auto enum_id : enum_ids) {
+			auto enum_value_ids = get_enum_value_ids(enum_id);
+			std::sort(enum_value_ids.begin(), enum_value_ids.end());
+			hasher.add(enum_id);
+			hasher.add(ecsact_meta_enum_storage_type(enum_id));
+			for(auto enum_value_id : enum_value_ids) {
+				hasher.add(enum_value_id);
+				hasher.add(ecsact_meta_enum_value(enum_id, enum_value_id));
+			}
+		}
+	}
+
+	return hasher.hash;
+}
+
 } // namespace ecsact::meta
@@ -0,0 +1,190 @@
+#ifndef ECSACT_RUNTIME_PROFILE_H
+#define ECSACT_RUNTIME_PROFILE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ecsact/runtime/common.h"
+
+#ifndef ECSACT_PROFILE_API_FN
+#	if defined(ECSACT_PROFILE_API)
+#		define ECSACT_PROFILE_API_FN(ret, name) ECSACT_PROFILE_API ret name
+#	elif defined(ECSACT_PROFILE_API_LOAD_AT_RUNTIME)
+#		if defined(ECSACT_PROFILE_API_EXPORT)
+#			define ECSACT_PROFILE_API_FN(ret, name) \
+				ECSACT_EXTERN ECSACT_EXPORT(#name) ret(*name)
+#		else
+#			define ECSACT_PROFILE_API_FN(ret, name) \
+				ECSACT_EXTERN ECSACT_IMPORT("env", #name) ret(*name)
+#		endif
+#	elif defined(ECSACT_PROFILE_API_EXPORT)
+#		define ECSACT_PROFILE_API_FN(ret, name) \
+			ECSACT_EXTERN ECSACT_EXPORT(#name) ret name
+#	else
+#		define ECSACT_PROFILE_API_FN(ret, name) \
+			ECSACT_EXTERN ECSACT_IMPORT("env", #name) ret name
+#	endif
+#endif // ECSACT_PROFILE_API_FN
+
+/**
+ * Timing and iteration details of a single system or action execution during
+ * `ecsact_execute_systems`.
+ *
+ * A sample is recorded per system, per worker thread, per execution. A system
+ * that runs on 4 threads produces 4 samples for the same execution.
+ */
+typedef struct ecsact_profile_system_sample {
+	/**
+	 * The system or action that was executed.
+	 */
+	ecsact_system_like_id system_like_id;
+
+	/**
+	 * Index of the worker thread the system ran on. `0` is always the thread
+	 * that called `ecsact_execute_systems`. Indices are stable for the lifetime
+	 * of the registry.
+	 */
+	int32_t thread_index;
+
+	/**
+	 * Monotonically increasing execution counter for the registry. Each
+	 * execution within an `ecsact_execute_systems` call (@see execution_count)
+	 * increments this by one.
+	 */
+	int64_t execution_index;
+
+	/**
+	 * Start time in nanoseconds. Relative to an implementation defined
+	 * monotonic epoch that is the same for every sample of a process.
+	 * @see ecsact_profile_now
+	 */
+	int64_t start_ns;
+
+	/**
+	 * Wall time in nanoseconds the system took on @ref thread_index. Includes
+	 * time spent in nested systems.
+	 */
+	int64_t duration_ns;
+
+	/**
+	 * Number of entities the system execution impl was invoked with.
+	 */
+	int32_t entities_iterated;
+
+	/**
+	 * Number of entities that matched the systems capabilities but were skipped
+	 * due to notify settings. @see ecsact_system_notify_setting
+	 */
+	int32_t entities_skipped;
+} ecsact_profile_system_sample;
+
+/**
+ * Invoked with every sample recorded during an `ecsact_execute_systems` call.
+ * Invocation happens in the thread that called `ecsact_execute_systems` after
+ * all executions are finished. @p samples is only valid during the callback.
+ */
+typedef void (*ecsact_profile_system_samples_callback)( //
+	ecsact_registry_id                  registry_id,
+	int32_t                             samples_count,
+	const ecsact_profile_system_sample* samples,
+	void*                               callback_user_data
+);
+
+/**
+ * Holds profile callbacks and their user data
+ */
+typedef struct ecsact_profile_events_collector {
+	/**
+	 * invoked after each `ecsact_execute_systems` call with the samples recorded
+	 * during that call. May be NULL.
+	 */
+	ecsact_profile_system_samples_callback system_samples_callback;
+
+	/**
+	 * `callback_user_data` passed to `system_samples_callback`
+	 */
+	void* system_samples_callback_user_data;
+} ecsact_profile_events_collector;
+
+/**
+ * Begin recording samples for @p registry_id. Profiling is disabled by default.
+ * While disabled implementations must not read any clocks or record anything
+ * so that the cost of profiling support is a single branch per system.
+ *
+ * Calling this while already profiling replaces the previous settings.
+ *
+ * @param events_collector (Optional) callbacks invoked with samples. The
+ *        collector is copied.
+ * @param max_buffered_samples maximum number of samples kept for
+ *        `ecsact_profile_get_samples`. When full the oldest samples are
+ *        dropped. `0` disables the pull API.
+ */
+ECSACT_PROFILE_API_FN(void, ecsact_profile_start)
+( //
+	ecsact_registry_id                     registry_id,
+	const ecsact_profile_events_collector* events_collector,
+	int32_t                                max_buffered_samples
+);
+
+/**
+ * Stop recording samples for @p registry_id. Buffered samples are kept until
+ * they are retrieved with `ecsact_profile_get_samples` or the registry is
+ * destroyed.
+ */
+ECSACT_PROFILE_API_FN(void, ecsact_profile_stop)
+( //
+	ecsact_registry_id registry_id
+);
+
+/**
+ * @returns `true` if @p registry_id is currently recording samples
+ */
+ECSACT_PROFILE_API_FN(bool, ecsact_profile_enabled)
+( //
+	ecsact_registry_id registry_id
+);
+
+/**
+ * @returns number of buffered samples available to `ecsact_profile_get_samples`
+ */
+ECSACT_PROFILE_API_FN(int32_t, ecsact_profile_count_samples)
+( //
+	ecsact_registry_id registry_id
+);
+
+/**
+ * Moves up to @p max_samples_count of the oldest buffered samples into
+ * @p out_samples. Retrieved samples are removed from the buffer.
+ *
+ * Must not be called while `ecsact_execute_systems` is running on
+ * @p registry_id.
+ */
+ECSACT_PROFILE_API_FN(void, ecsact_profile_get_samples)
+( //
+	ecsact_registry_id            registry_id,
+	int32_t                       max_samples_count,
+	ecsact_profile_system_sample* out_samples,
+	int32_t*                      out_samples_count
+);
+
+/**
+ * @returns the current time in nanoseconds using the same clock and epoch as
+ * `ecsact_profile_system_sample::start_ns`. Useful for placing user markers
+ * alongside samples.
+ */
+ECSACT_PROFILE_API_FN(int64_t, ecsact_profile_now)();
+
+// # BEGIN FOR_EACH_ECSACT_PROFILE_API_FN
+#ifdef ECSACT_MSVC_TRADITIONAL
+#	define FOR_EACH_ECSACT_PROFILE_API_FN(fn, ...) \
+		ECSACT_MSVC_TRADITIONAL_ERROR()
+#else
+#	define FOR_EACH_ECSACT_PROFILE_API_FN(fn, ...)  \
+		fn(ecsact_profile_start, __VA_ARGS__);         \
+		fn(ecsact_profile_stop, __VA_ARGS__);          \
+		fn(ecsact_profile_enabled, __VA_ARGS__);       \
+		fn(ecsact_profile_count_samples, __VA_ARGS__); \
+		fn(ecsact_profile_get_samples, __VA_ARGS__);   \
+		fn(ecsact_profile_now, __VA_ARGS__)
+#endif
+
+#endif // ECSACT_RUNTIME_PROFILE_H
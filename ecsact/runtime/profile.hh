@@ -0,0 +1,52 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include "ecsact/runtime/profile.h"
+
+namespace ecsact::profile {
+
+ECSACT_ALWAYS_INLINE auto start(
+	ecsact_registry_id registry_id,
+	int32_t            max_buffered_samples
+) -> void {
+	ecsact_profile_start(registry_id, nullptr, max_buffered_samples);
+}
+
+ECSACT_ALWAYS_INLINE auto start(
+	ecsact_registry_id                     registry_id,
+	const ecsact_profile_events_collector& events_collector,
+	int32_t                                max_buffered_samples = 0
+) -> void {
+	ecsact_profile_start(registry_id, &events_collector, max_buffered_samples);
+}
+
+ECSACT_ALWAYS_INLINE auto stop(ecsact_registry_id registry_id) -> void {
+	ecsact_profile_stop(registry_id);
+}
+
+ECSACT_ALWAYS_INLINE auto enabled(ecsact_registry_id registry_id) -> bool {
+	return ecsact_profile_enabled(registry_id);
+}
+
+/**
+ * Moves all buffered samples out of the registry.
+ * @see ecsact_profile_get_samples
+ */
+ECSACT_ALWAYS_INLINE auto get_samples( //
+	ecsact_registry_id registry_id
+) -> std::vector<ecsact_profile_system_sample> {
+	auto samples = std::vector<ecsact_profile_system_sample>{};
+	samples.resize(ecsact_profile_count_samples(registry_id));
+	auto samples_count = int32_t{};
+	ecsact_profile_get_samples(
+		registry_id,
+		static_cast<int32_t>(samples.size()),
+		samples.data(),
+		&samples_count
+	);
+	samples.resize(samples_count);
+	return samples;
+}
+
+} // namespace ecsact::profile
@@ -1,6 +1,7 @@
 #ifndef ECSACT_RUNTIME_SERIALIZE_H
 #define ECSACT_RUNTIME_SERIALIZE_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include "ecsact/runtime/common.h"
@@ -29,6 +30,16 @@
 #	endif
 #endif // ECSACT_SERIALIZE_API_FN
 
+/**
+ * Structs shared between runtimes or written to disk have explicit padding so
+ * their layout is the same on every ABI. This checks it at compile time.
+ */
+#ifdef __cplusplus
+#	define ECSACT_SERIALIZE_LAYOUT_ASSERT(expr) static_assert(expr, #expr)
+#else
+#	define ECSACT_SERIALIZE_LAYOUT_ASSERT(expr) _Static_assert(expr, #expr)
+#endif
+
 /**
  * Get the amount of bytes an action with id `action_id` requires to serialize.
  */
@@ -87,6 +98,124 @@ ECSACT_SERIALIZE_API_FN(int, ecsact_deserialize_component)
 	void*               out_component_data
 );
 
+/**
+ * Wire encoding used by the `_ex` serialize functions. Both encodings write
+ * fields in the order given by `ecsact_meta_get_field_ids` using the type
+ * from `ecsact_meta_field_type` and are deserializable across platforms.
+ */
+typedef enum ecsact_serialize_encoding {
+	/**
+	 * Same encoding as `ecsact_serialize_component` and
+	 * `ecsact_serialize_action`. Every component or action of the same type has
+	 * the same serialized size.
+	 */
+	ECSACT_SERIALIZE_ENCODING_FIXED = 0,
+
+	/**
+	 * Variable size encoding intended for networking:
+	 *  - every `ECSACT_BOOL` field is packed into a leading bit set, one bit per
+	 *    bool in field order, padded to a whole byte
+	 *  - signed integers and enums with a signed storage type are zigzag
+	 *    encoded LEB128 varints
+	 *  - unsigned integers, enums with an unsigned storage type and
+	 *    `ECSACT_ENTITY_TYPE` are LEB128 varints
+	 *  - `ECSACT_I8`, `ECSACT_U8` and `ECSACT_F32` are written as is in little
+	 *    endian
+	 *  - array fields encode each element in order
+	 *
+	 * Floats are not quantized since there is no field metadata describing an
+	 * acceptable range or precision.
+	 */
+	ECSACT_SERIALIZE_ENCODING_COMPACT = 1,
+} ecsact_serialize_encoding;
+
+/**
+ * Get the maximum amount of bytes a component with id @p component_id may
+ * require to serialize with @p encoding. For
+ * `ECSACT_SERIALIZE_ENCODING_FIXED` this is the same as
+ * `ecsact_serialize_component_size`.
+ */
+ECSACT_SERIALIZE_API_FN(int, ecsact_serialize_component_max_size)
+( //
+	ecsact_component_id       component_id,
+	ecsact_serialize_encoding encoding
+);
+
+/**
+ * Get the maximum amount of bytes an action with id @p action_id may require
+ * to serialize with @p encoding. For `ECSACT_SERIALIZE_ENCODING_FIXED` this is
+ * the same as `ecsact_serialize_action_size`.
+ */
+ECSACT_SERIALIZE_API_FN(int, ecsact_serialize_action_max_size)
+( //
+	ecsact_action_id          action_id,
+	ecsact_serialize_encoding encoding
+);
+
+/**
+ * Same as `ecsact_serialize_component` with a selectable @p encoding.
+ *
+ * @param out_bytes must have at least as many bytes as
+ *        `ecsact_serialize_component_max_size` returns for @p encoding
+ * @returns amount of bytes written to @p out_bytes
+ */
+ECSACT_SERIALIZE_API_FN(int, ecsact_serialize_component_ex)
+( //
+	ecsact_component_id       component_id,
+	ecsact_serialize_encoding encoding,
+	const void*               in_component_data,
+	uint8_t*                  out_bytes
+);
+
+/**
+ * Same as `ecsact_deserialize_component` for bytes written by
+ * `ecsact_serialize_component_ex` with the same @p encoding.
+ *
+ * @param in_bytes_length amount of readable bytes in @p in_bytes
+ * @returns amount of bytes read from @p in_bytes or `-1` if @p in_bytes ended
+ *          before the component was fully read
+ */
+ECSACT_SERIALIZE_API_FN(int, ecsact_deserialize_component_ex)
+( //
+	ecsact_component_id       component_id,
+	ecsact_serialize_encoding encoding,
+	const uint8_t*            in_bytes,
+	int32_t                   in_bytes_length,
+	void*                     out_component_data
+);
+
+/**
+ * Same as `ecsact_serialize_action` with a selectable @p encoding.
+ *
+ * @param out_bytes must have at least as many bytes as
+ *        `ecsact_serialize_action_max_size` returns for @p encoding
+ * @returns amount of bytes written to @p out_bytes
+ */
+ECSACT_SERIALIZE_API_FN(int, ecsact_serialize_action_ex)
+( //
+	ecsact_action_id          action_id,
+	ecsact_serialize_encoding encoding,
+	const void*               in_action_data,
+	uint8_t*                  out_bytes
+);
+
+/**
+ * Same as `ecsact_deserialize_action` for bytes written by
+ * `ecsact_serialize_action_ex` with the same @p encoding.
+ *
+ * @param in_bytes_length amount of readable bytes in @p in_bytes
+ * @returns amount of bytes read from @p in_bytes or `-1` if @p in_bytes ended
+ *          before the action was fully read
+ */
+ECSACT_SERIALIZE_API_FN(int, ecsact_deserialize_action_ex)
+( //
+	ecsact_action_id          action_id,
+	ecsact_serialize_encoding encoding,
+	const uint8_t*            in_bytes,
+	int32_t                   in_bytes_length,
+	void*                     out_action_data
+);
+
 typedef void (*ecsact_dump_entities_callback)( //
 	const void* data,
 	int32_t     data_length,
@@ -139,6 +268,19 @@ typedef enum ecsact_restore_error {
 	 * same runtime.
 	 */
 	ECSACT_RESTORE_ERR_INVALID_FORMAT = 3,
+
+	/**
+	 * Data was dumped with `ECSACT_DUMP_FILTER_XOR_REFERENCE` and no or a
+	 * different reference dump was given.
+	 */
+	ECSACT_RESTORE_ERR_REFERENCE_MISMATCH = 4,
+
+	/**
+	 * The @ref ecsact_restore_arena given to
+	 * `ecsact_restore_as_execution_options_arena` does not have enough capacity.
+	 * The arena `used` field is set to the required capacity.
+	 */
+	ECSACT_RESTORE_ERR_ARENA_TOO_SMALL = 5,
 } ecsact_restore_error;
 
 /**
@@ -162,6 +304,11 @@ typedef void (*ecsact_restore_as_execution_options_callback)( //
  * Invokes @p callback until it returns `0` creating entities and adding
  * components from data given from the @p callback into some @ref
  * ecsact_execution_options which is passed to the @p done_callback.
+ *
+ * The lists and component data in the execution options are owned by the
+ * runtime and are only valid until @p done_callback returns. Use
+ * `ecsact_restore_as_execution_options_arena` to avoid the runtime allocating
+ * them on every call.
  */
 ECSACT_SERIALIZE_API_FN(
 	ecsact_restore_error,
@@ -174,21 +321,756 @@ ECSACT_SERIALIZE_API_FN(
 	void*                                        done_callback_user_data
 );
 
+/**
+ * Caller owned memory that `ecsact_restore_as_execution_options_arena`
+ * decodes into.
+ */
+typedef struct ecsact_restore_arena {
+	/**
+	 * Start of the arena. Must be aligned to at least 16 bytes.
+	 */
+	void* data;
+
+	/**
+	 * Size of @ref data in bytes
+	 */
+	int64_t capacity;
+
+	/**
+	 * Bytes used by the last restore. When the restore fails with
+	 * `ECSACT_RESTORE_ERR_ARENA_TOO_SMALL` this is the capacity needed for the
+	 * entire input.
+	 */
+	int64_t used;
+} ecsact_restore_arena;
+
+/**
+ * Same as `ecsact_restore_as_execution_options` except every list and all
+ * component data in @p out_execution_options are placed in @p arena. The
+ * runtime does not allocate any memory when the arena is large enough, so
+ * reusing the same arena for every restore has no steady state allocations.
+ *
+ * Everything in @p out_execution_options points into @p arena and stays valid
+ * until the arena memory is reused for another restore or freed by the
+ * caller. Passing the execution options to `ecsact_execute_systems` or
+ * `ecsact_async_enqueue_execution_options` does not extend this lifetime.
+ *
+ * If the arena is too small `ECSACT_RESTORE_ERR_ARENA_TOO_SMALL` is returned,
+ * @p out_execution_options is left unchanged and `arena->used` is set to the
+ * required capacity. The required capacity depends on the data, so @p callback
+ * is still read until it returns `0` to compute it. To retry with a larger
+ * arena the caller must rewind whatever @p callback reads from so it returns
+ * the same data from the start again.
+ */
+ECSACT_SERIALIZE_API_FN(
+	ecsact_restore_error,
+	ecsact_restore_as_execution_options_arena
+)
+( //
+	ecsact_restore_entities_callback callback,
+	void*                            callback_user_data,
+	ecsact_restore_arena*            arena,
+	ecsact_execution_options*        out_execution_options
+);
+
+/**
+ * Identifies an export created by `ecsact_handoff_export`. 'ECHO' in little
+ * endian.
+ */
+#define ECSACT_HANDOFF_MAGIC 0x4F484345u
+
+/**
+ * Layout version of the handoff region structs
+ */
+#define ECSACT_HANDOFF_VERSION 3
+
+/**
+ * Byte alignment of every array inside a handoff region. Offsets in the
+ * handoff structs are always a multiple of this.
+ */
+#define ECSACT_HANDOFF_ALIGNMENT 64
+
+/**
+ * Layout of a single field in the exporting runtime
+ */
+typedef struct ecsact_handoff_field_layout {
+	ecsact_field_id field_id;
+
+	/**
+	 * `ecsact_meta_field_offset` in the exporting runtime
+	 */
+	int32_t offset;
+
+	/**
+	 * Size of the field in bytes including fixed array length
+	 */
+	int32_t size;
+} ecsact_handoff_field_layout;
+
+ECSACT_SERIALIZE_LAYOUT_ASSERT(sizeof(ecsact_handoff_field_layout) == 12);
+
+/**
+ * One component column in a handoff region. Component data is stored tightly
+ * packed in the exporting runtimes in-memory layout so an adopting runtime
+ * with the same layout can use it without copying.
+ */
+typedef struct ecsact_handoff_component_layout {
+	ecsact_component_id component_id;
+
+	/**
+	 * Size in bytes of a single component
+	 */
+	int32_t component_size;
+
+	int32_t fields_count;
+
+	/**
+	 * Always `0`
+	 */
+	int32_t reserved0;
+
+	/**
+	 * Byte offset from the region start to `fields_count`
+	 * @ref ecsact_handoff_field_layout
+	 */
+	int64_t fields_offset;
+
+	/**
+	 * Number of entities that have this component
+	 */
+	int32_t entities_count;
+
+	/**
+	 * Always `0`
+	 */
+	int32_t reserved1;
+
+	/**
+	 * Byte offset from the region start to `entities_count` entity IDs
+	 */
+	int64_t entities_offset;
+
+	/**
+	 * Byte offset from the region start to `entities_count * component_size`
+	 * bytes of component data. Data at index N belongs to entity at index N.
+	 */
+	int64_t data_offset;
+} ecsact_handoff_component_layout;
+
+ECSACT_SERIALIZE_LAYOUT_ASSERT(sizeof(ecsact_handoff_component_layout) == 48);
+ECSACT_SERIALIZE_LAYOUT_ASSERT(
+	offsetof(ecsact_handoff_component_layout, fields_offset) == 16
+);
+ECSACT_SERIALIZE_LAYOUT_ASSERT(
+	offsetof(ecsact_handoff_component_layout, entities_offset) == 32
+);
+ECSACT_SERIALIZE_LAYOUT_ASSERT(
+	offsetof(ecsact_handoff_component_layout, data_offset) == 40
+);
+
+/**
+ * Always at the start of a handoff region
+ */
+typedef struct ecsact_handoff_header {
+	/**
+	 * Always `ECSACT_HANDOFF_MAGIC`
+	 */
+	uint32_t magic;
+
+	/**
+	 * `ECSACT_HANDOFF_VERSION` of the exporting runtime
+	 */
+	uint32_t version;
+
+	/**
+	 * `ecsact_meta_schema_hash` of the exporting runtime
+	 */
+	uint64_t schema_hash;
+
+	/**
+	 * Total bytes used by the export including this header
+	 */
+	int64_t region_size;
+
+	int32_t entities_count;
+
+	/**
+	 * Always `0`
+	 */
+	int32_t reserved0;
+
+	/**
+	 * Byte offset from the region start to `entities_count` entity IDs. Entity
+	 * IDs are kept when adopted.
+	 */
+	int64_t entities_offset;
+
+	int32_t components_count;
+
+	/**
+	 * Always `0`
+	 */
+	int32_t reserved1;
+
+	/**
+	 * Byte offset from the region start to `components_count`
+	 * @ref ecsact_handoff_component_layout
+	 */
+	int64_t components_offset;
+} ecsact_handoff_header;
+
+ECSACT_SERIALIZE_LAYOUT_ASSERT(sizeof(ecsact_handoff_header) == 56);
+ECSACT_SERIALIZE_LAYOUT_ASSERT(
+	offsetof(ecsact_handoff_header, region_size) == 16
+);
+ECSACT_SERIALIZE_LAYOUT_ASSERT(
+	offsetof(ecsact_handoff_header, entities_offset) == 32
+);
+ECSACT_SERIALIZE_LAYOUT_ASSERT(
+	offsetof(ecsact_handoff_header, components_offset) == 48
+);
+
+typedef enum ecsact_handoff_error {
+	ECSACT_HANDOFF_OK = 0,
+
+	/**
+	 * Region passed to `ecsact_handoff_export` is smaller than
+	 * `ecsact_handoff_export_size`.
+	 */
+	ECSACT_HANDOFF_ERR_REGION_TOO_SMALL = 1,
+
+	/**
+	 * Region is not aligned to `ECSACT_HANDOFF_ALIGNMENT` or its header is
+	 * invalid.
+	 */
+	ECSACT_HANDOFF_ERR_INVALID_FORMAT = 2,
+
+	/**
+	 * Region was exported with a different `ECSACT_HANDOFF_VERSION`. Fall back
+	 * to `ecsact_dump_entities` and `ecsact_restore_entities`.
+	 */
+	ECSACT_HANDOFF_ERR_VERSION_MISMATCH = 3,
+} ecsact_handoff_error;
+
+/**
+ * @returns number of bytes `ecsact_handoff_export` needs to export
+ *          @p registry_id
+ */
+ECSACT_SERIALIZE_API_FN(int64_t, ecsact_handoff_export_size)
+( //
+	ecsact_registry_id registry_id
+);
+
+/**
+ * Writes the entire state of @p registry_id into @p region as described by
+ * @ref ecsact_handoff_header. Used to hand a registry over to a newly loaded
+ * runtime during a hot reload without going through `ecsact_dump_entities`.
+ *
+ * A typical reload looks like:
+ *  1. host maps a shared region of `ecsact_handoff_export_size` bytes
+ *  2. old runtime `ecsact_handoff_export`
+ *  3. old runtime is unloaded, new runtime is loaded
+ *  4. new runtime `ecsact_handoff_adopt` on a new registry
+ *  5. new runtime `ecsact_handoff_release` once the region should be unmapped
+ *
+ * The registry is left unchanged.
+ *
+ * @param region host owned memory aligned to `ECSACT_HANDOFF_ALIGNMENT`. Page
+ *        aligned memory from mmap or MapViewOfFile is recommended so it can
+ *        outlive the exporting runtime.
+ */
+ECSACT_SERIALIZE_API_FN(ecsact_handoff_error, ecsact_handoff_export)
+( //
+	ecsact_registry_id registry_id,
+	void*              region,
+	int64_t            region_size
+);
+
+/**
+ * Clears @p registry_id and replaces its state with the registry exported in
+ * @p region. Entity IDs are kept.
+ *
+ * When the header `schema_hash` equals this runtime's `ecsact_meta_schema_hash`
+ * every column is used directly from @p region without comparing layouts.
+ * Otherwise component columns whose size and every field offset and size match
+ * this runtime (@see ecsact_meta_field_offset) are still used directly and
+ * other columns are converted by field ID: removed fields are dropped, new
+ * fields are zero initialized and components unknown to this runtime are
+ * dropped. The region must stay mapped and unmodified until
+ * `ecsact_handoff_release` is called.
+ *
+ * @param events_collector (Optional) invoked with an init event for every
+ *        adopted component. Usually NULL during a reload.
+ */
+ECSACT_SERIALIZE_API_FN(ecsact_handoff_error, ecsact_handoff_adopt)
+( //
+	ecsact_registry_id                       registry_id,
+	void*                                    region,
+	int64_t                                  region_size,
+	const ecsact_execution_events_collector* events_collector
+);
+
+/**
+ * Copies any component data @p registry_id still uses from its adopted handoff
+ * region into runtime owned memory. After this returns the region may be
+ * unmapped. Runtimes may also call this implicitly the first time a borrowed
+ * column needs to grow.
+ */
+ECSACT_SERIALIZE_API_FN(void, ecsact_handoff_release)
+( //
+	ecsact_registry_id registry_id
+);
+
+/**
+ * Identifies a column dump created by `ecsact_dump_entities_columns`. 'ECCD'
+ * in little endian.
+ */
+#define ECSACT_COLUMN_DUMP_MAGIC 0x44434345u
+
+/**
+ * Layout version of the column dump structs
+ */
+#define ECSACT_COLUMN_DUMP_VERSION 3
+
+/**
+ * Every array in a column dump starts at an offset that is a multiple of this
+ * so a mapped dump can use each column in place.
+ */
+#define ECSACT_COLUMN_DUMP_ALIGNMENT 4096
+
+/**
+ * Always at the start of a column dump
+ */
+typedef struct ecsact_column_dump_header {
+	/**
+	 * Always `ECSACT_COLUMN_DUMP_MAGIC`
+	 */
+	uint32_t magic;
+
+	/**
+	 * `ECSACT_COLUMN_DUMP_VERSION` of the dumping runtime
+	 */
+	uint32_t version;
+
+	/**
+	 * `ecsact_meta_schema_hash` of the dumping runtime
+	 */
+	uint64_t schema_hash;
+
+	/**
+	 * Total size of the dump in bytes without the trailing padding of
+	 * `ECSACT_DUMP_COLUMNS_ALIGNED`
+	 */
+	int64_t dump_size;
+
+	int32_t entities_count;
+
+	/**
+	 * Always `0`
+	 */
+	int32_t reserved0;
+
+	/**
+	 * Byte offset from the dump start to `entities_count` entity IDs
+	 */
+	int64_t entities_offset;
+
+	int32_t columns_count;
+
+	/**
+	 * Always `0`
+	 */
+	int32_t reserved1;
+
+	/**
+	 * Byte offset from the dump start to `columns_count`
+	 * @ref ecsact_handoff_component_layout. Offsets inside each column are
+	 * relative to the dump start.
+	 */
+	int64_t columns_offset;
+} ecsact_column_dump_header;
+
+ECSACT_SERIALIZE_LAYOUT_ASSERT(sizeof(ecsact_column_dump_header) == 56);
+ECSACT_SERIALIZE_LAYOUT_ASSERT(
+	offsetof(ecsact_column_dump_header, dump_size) == 16
+);
+ECSACT_SERIALIZE_LAYOUT_ASSERT(
+	offsetof(ecsact_column_dump_header, entities_offset) == 32
+);
+ECSACT_SERIALIZE_LAYOUT_ASSERT(
+	offsetof(ecsact_column_dump_header, columns_offset) == 48
+);
+
+/**
+ * A contiguous piece of a column dump. Segments are views of memory owned by
+ * the runtime. Alignment depends on @ref ecsact_dump_columns_mode.
+ */
+typedef struct ecsact_dump_segment {
+	const void* data;
+
+	/**
+	 * Length of @ref data in bytes
+	 */
+	int64_t length;
+
+	/**
+	 * Byte offset of this segment from the dump start
+	 */
+	int64_t offset;
+} ecsact_dump_segment;
+
+/**
+ * @param segments contiguous segments in ascending offset order. Only valid
+ *        during the callback. Suitable to pass directly to `writev`.
+ */
+typedef void (*ecsact_dump_segments_callback)( //
+	const ecsact_dump_segment* segments,
+	int32_t                    segments_count,
+	void*                      callback_user_data
+);
+
+typedef enum ecsact_dump_columns_mode {
+	/**
+	 * Segments for entity IDs and component data point directly at the
+	 * registry's storage so no component data is copied. The header, column
+	 * table and the zero padding that aligns each array to
+	 * `ECSACT_COLUMN_DUMP_ALIGNMENT` in the dump are separate segments.
+	 * Segment @ref ecsact_dump_segment::data and
+	 * @ref ecsact_dump_segment::length have no alignment guarantee.
+	 */
+	ECSACT_DUMP_COLUMNS_VIEW = 0,
+
+	/**
+	 * Every segment @ref ecsact_dump_segment::data is aligned to
+	 * `ECSACT_COLUMN_DUMP_ALIGNMENT` and every offset and length is a multiple
+	 * of it, so segments may be written with `O_DIRECT` as is. The runtime
+	 * stages the dump through its own aligned buffers, copying every byte once.
+	 *
+	 * The last segment is zero padded past the header `dump_size` up to the
+	 * alignment. Restores ignore bytes after `dump_size`.
+	 */
+	ECSACT_DUMP_COLUMNS_ALIGNED = 1,
+} ecsact_dump_columns_mode;
+
+/**
+ * Dumps @p registry as a column dump (@see ecsact_column_dump_header).
+ * @p callback is invoked an unspecified amount of times in ascending offset
+ * order. The dump bytes are the same in every @p mode; only how they are split
+ * into segments differs.
+ *
+ * The registry must not be modified while dumping.
+ */
+ECSACT_SERIALIZE_API_FN(void, ecsact_dump_entities_columns)
+( //
+	ecsact_registry_id            registry,
+	ecsact_dump_columns_mode      mode,
+	ecsact_dump_segments_callback callback,
+	void*                         callback_user_data
+);
+
+typedef enum ecsact_restore_mapped_mode {
+	/**
+	 * Every column is copied into runtime owned storage with a single memcpy
+	 * per column where the layout matches. The dump may be unmapped as soon as
+	 * `ecsact_restore_entities_mapped` returns.
+	 */
+	ECSACT_RESTORE_MAPPED_COPY = 0,
+
+	/**
+	 * Columns whose layout matches the runtime are used directly as component
+	 * storage. The dump must stay mapped until `ecsact_restore_mapped_release`
+	 * is called. Writes to borrowed columns modify the mapping so map the dump
+	 * copy-on-write (e.g. `MAP_PRIVATE`) to leave the file untouched.
+	 */
+	ECSACT_RESTORE_MAPPED_BORROW = 1,
+} ecsact_restore_mapped_mode;
+
+/**
+ * Clears @p registry and restores a column dump created by
+ * `ecsact_dump_entities_columns` from memory, typically an mmap of the dump
+ * file. Entity IDs are kept.
+ *
+ * When the header `schema_hash` matches this runtime every column is restored
+ * as is. Otherwise columns whose layout does not match this runtime are
+ * converted by field ID the same as `ecsact_handoff_adopt`.
+ *
+ * @param dump start of the dump aligned to `ECSACT_COLUMN_DUMP_ALIGNMENT`
+ * @param dump_size bytes readable at @p dump. At least the header
+ *        `dump_size`, larger for a dump written with
+ *        `ECSACT_DUMP_COLUMNS_ALIGNED`.
+ */
+ECSACT_SERIALIZE_API_FN(ecsact_restore_error, ecsact_restore_entities_mapped)
+( //
+	ecsact_registry_id                       registry,
+	void*                                    dump,
+	int64_t                                  dump_size,
+	ecsact_restore_mapped_mode               mode,
+	const ecsact_execution_events_collector* events_collector
+);
+
+/**
+ * Copies any borrowed column of @p registry into runtime owned storage. After
+ * this returns the dump given to `ecsact_restore_entities_mapped` may be
+ * unmapped. Does nothing if nothing is borrowed.
+ */
+ECSACT_SERIALIZE_API_FN(void, ecsact_restore_mapped_release)
+( //
+	ecsact_registry_id registry
+);
+
+/**
+ * Read @p length bytes at @p offset of a column dump into @p out_data.
+ * Invoked concurrently from multiple threads with non-overlapping ranges.
+ *
+ * @returns number of bytes read. Anything other than @p length stops the
+ *          restore with `ECSACT_RESTORE_ERR_UNEXPECTED_READ_LENGTH`.
+ */
+typedef int64_t (*ecsact_restore_read_range_callback)( //
+	void*   out_data,
+	int64_t offset,
+	int64_t length,
+	void*   callback_user_data
+);
+
+/**
+ * Clears @p registry and restores a column dump created by
+ * `ecsact_dump_entities_columns` using multiple threads. The header and column
+ * table are read first, then each column is read, decoded and inserted on its
+ * own thread. Entity IDs are kept.
+ *
+ * Events are invoked on the calling thread after every column is inserted and
+ * in the same order regardless of @p thread_count: an entity created event
+ * for each entity in the order of the dump entity list, then an init event
+ * for each component of each entity in that same entity order with
+ * components in column table order.
+ *
+ * @param callback reads byte ranges of the dump. Typically `pread` on the dump
+ *        file.
+ * @param thread_count maximum number of threads used. `0` uses the registry
+ *        thread count (@see ecsact_registry_options::thread_count).
+ */
+ECSACT_SERIALIZE_API_FN(ecsact_restore_error, ecsact_restore_entities_parallel)
+( //
+	ecsact_registry_id                       registry,
+	ecsact_restore_read_range_callback       callback,
+	void*                                    callback_user_data,
+	int32_t                                  thread_count,
+	const ecsact_execution_events_collector* events_collector
+);
+
+/**
+ * Reversible transforms applied to component columns so the dump compresses
+ * better with a general purpose compressor. May be combined.
+ */
+typedef enum ecsact_dump_filter {
+	ECSACT_DUMP_FILTER_NONE = 0,
+
+	/**
+	 * Entity IDs are stored as the difference from the previous entity ID
+	 */
+	ECSACT_DUMP_FILTER_DELTA_ENTITY_IDS = 1,
+
+	/**
+	 * Component data is stored XOR'd with the same component of the same entity
+	 * in @ref ecsact_dump_options::reference. Unchanged fields become zeros.
+	 */
+	ECSACT_DUMP_FILTER_XOR_REFERENCE = 2,
+} ecsact_dump_filter;
+
+typedef struct ecsact_dump_options {
+	/**
+	 * Bitwise or of @ref ecsact_dump_filter
+	 */
+	int32_t filters;
+
+	/**
+	 * Bytes per frame. Each frame is filtered independently so restoring never
+	 * holds more than one frame. `0` uses an implementation defined default.
+	 */
+	int32_t frame_size;
+
+	/**
+	 * Data of a previous `ecsact_dump_entities` call, typically the previous
+	 * tick. Required for `ECSACT_DUMP_FILTER_XOR_REFERENCE`.
+	 */
+	const void* reference;
+	int64_t     reference_size;
+
+	/**
+	 * Write an @ref ecsact_dump_schema_header and the dumped component layouts
+	 * before any frame so the dump can be restored by a runtime built with a
+	 * different schema.
+	 */
+	bool schema_header;
+} ecsact_dump_options;
+
+/**
+ * Identifies a filtered dump frame. 'ECZF' in little endian.
+ */
+#define ECSACT_DUMP_FRAME_MAGIC 0x465A4345u
+
+/**
+ * Precedes every frame written by `ecsact_dump_entities_ex` when a filter is
+ * used. Frames are self describing so `ecsact_restore_entities_ex` does not
+ * need the options used to dump.
+ */
+typedef struct ecsact_dump_frame_header {
+	/**
+	 * Always `ECSACT_DUMP_FRAME_MAGIC`
+	 */
+	uint32_t magic;
+
+	/**
+	 * @ref ecsact_dump_filter applied to this frame
+	 */
+	int32_t filters;
+
+	/**
+	 * Bytes following this header
+	 */
+	int32_t size;
+
+	/**
+	 * Always `0`
+	 */
+	int32_t reserved;
+} ecsact_dump_frame_header;
+
+ECSACT_SERIALIZE_LAYOUT_ASSERT(sizeof(ecsact_dump_frame_header) == 16);
+
+/**
+ * Identifies an @ref ecsact_dump_schema_header. 'ECSH' in little endian.
+ */
+#define ECSACT_DUMP_SCHEMA_MAGIC 0x48534345u
+
+/**
+ * First bytes of data from `ecsact_dump_entities_ex` when
+ * @ref ecsact_dump_options `schema_header` is set, before any frame. Never
+ * filtered. `ecsact_dump_entities` never writes it.
+ *
+ * It is followed by `layouts_size` bytes describing every component in the
+ * dump. Each component has an @ref ecsact_dump_component_layout followed by
+ * its `fields_count` @ref ecsact_handoff_field_layout.
+ *
+ * When `schema_hash` matches `ecsact_meta_schema_hash` the restoring runtime
+ * copies component data as is and may skip the layouts. Otherwise it converts
+ * every component by field ID the same as `ecsact_handoff_adopt`. Removed
+ * fields are dropped, new fields are zero initialized and components unknown
+ * to the restoring runtime are dropped.
+ */
+typedef struct ecsact_dump_schema_header {
+	/**
+	 * Always `ECSACT_DUMP_SCHEMA_MAGIC`
+	 */
+	uint32_t magic;
+
+	/**
+	 * Bytes of component layouts following this header
+	 */
+	uint32_t layouts_size;
+
+	/**
+	 * `ecsact_meta_schema_hash` of the dumping runtime
+	 */
+	uint64_t schema_hash;
+} ecsact_dump_schema_header;
+
+ECSACT_SERIALIZE_LAYOUT_ASSERT(sizeof(ecsact_dump_schema_header) == 16);
+
+/**
+ * Layout of one component in the dumping runtime. @see
+ * ecsact_dump_schema_header
+ */
+typedef struct ecsact_dump_component_layout {
+	ecsact_component_id component_id;
+
+	/**
+	 * Size in bytes of a single component
+	 */
+	int32_t component_size;
+
+	int32_t fields_count;
+
+	/**
+	 * Always `0`
+	 */
+	int32_t reserved;
+} ecsact_dump_component_layout;
+
+ECSACT_SERIALIZE_LAYOUT_ASSERT(sizeof(ecsact_dump_component_layout) == 16);
+
+/**
+ * Same as `ecsact_dump_entities` but the data passed to @p callback is split
+ * into frames (@see ecsact_dump_frame_header) filtered with @p options.
+ * Nothing is compressed; filtered dumps are meant to be fed to a general
+ * purpose compressor by the caller.
+ *
+ * @param options (Optional) NULL behaves the same as `ecsact_dump_entities`
+ * @returns `false` if @p options has unknown filter bits or uses
+ *          `ECSACT_DUMP_FILTER_XOR_REFERENCE` without a reference, in which
+ *          case @p callback is never invoked
+ */
+ECSACT_SERIALIZE_API_FN(bool, ecsact_dump_entities_ex)
+( //
+	ecsact_registry_id            registry,
+	const ecsact_dump_options*    options,
+	ecsact_dump_entities_callback callback,
+	void*                         callback_user_data
+);
+
+/**
+ * Same as `ecsact_restore_entities` but accepts data from both
+ * `ecsact_dump_entities` and `ecsact_dump_entities_ex`. Data beginning with
+ * an @ref ecsact_dump_schema_header is converted by field ID when it was
+ * dumped with a different schema. Data without one must come from a runtime
+ * with the same schema.
+ *
+ * @param reference (Optional) the same reference given in
+ *        @ref ecsact_dump_options when dumping. Required to restore data
+ *        dumped with `ECSACT_DUMP_FILTER_XOR_REFERENCE`.
+ */
+ECSACT_SERIALIZE_API_FN(ecsact_restore_error, ecsact_restore_entities_ex)
+( //
+	ecsact_registry_id                       registry,
+	const void*                              reference,
+	int64_t                                  reference_size,
+	ecsact_restore_entities_callback         callback,
+	const ecsact_execution_events_collector* events_collector,
+	void*                                    callback_user_data
+);
+
 // # BEGIN FOR_EACH_ECSACT_SERIALIZE_API_FN
 #ifdef ECSACT_MSVC_TRADITIONAL
 #	define FOR_EACH_ECSACT_SERIALIZE_API_FN(fn, ...) \
 		ECSACT_MSVC_TRADITIONAL_ERROR()
 #else
-#	define FOR_EACH_ECSACT_SERIALIZE_API_FN(fn, ...)   \
-		fn(ecsact_serialize_action_size, __VA_ARGS__);    \
-		fn(ecsact_serialize_component_size, __VA_ARGS__); \
-		fn(ecsact_serialize_action, __VA_ARGS__);         \
-		fn(ecsact_deserialize_action, __VA_ARGS__);       \
-		fn(ecsact_serialize_component, __VA_ARGS__);      \
-		fn(ecsact_deserialize_component, __VA_ARGS__);    \
-		fn(ecsact_dump_entities, __VA_ARGS__);            \
-		fn(ecsact_restore_entities, __VA_ARGS__);         \
-		fn(ecsact_restore_as_execution_options, __VA_ARGS__)
+#	define FOR_EACH_ECSACT_SERIALIZE_API_FN(fn, ...)             \
+		fn(ecsact_serialize_action_size, __VA_ARGS__);              \
+		fn(ecsact_serialize_component_size, __VA_ARGS__);           \
+		fn(ecsact_serialize_action, __VA_ARGS__);                   \
+		fn(ecsact_deserialize_action, __VA_ARGS__);                 \
+		fn(ecsact_serialize_component, __VA_ARGS__);                \
+		fn(ecsact_deserialize_component, __VA_ARGS__);              \
+		fn(ecsact_dump_entities, __VA_ARGS__);                      \
+		fn(ecsact_restore_entities, __VA_ARGS__);                   \
+		fn(ecsact_restore_as_execution_options, __VA_ARGS__);       \
+		fn(ecsact_handoff_export_size, __VA_ARGS__);                \
+		fn(ecsact_handoff_export, __VA_ARGS__);                     \
+		fn(ecsact_handoff_adopt, __VA_ARGS__);                      \
+		fn(ecsact_handoff_release, __VA_ARGS__);                    \
+		fn(ecsact_dump_entities_columns, __VA_ARGS__);              \
+		fn(ecsact_restore_entities_mapped, __VA_ARGS__);            \
+		fn(ecsact_restore_mapped_release, __VA_ARGS__);             \
+		fn(ecsact_restore_entities_parallel, __VA_ARGS__);          \
+		fn(ecsact_dump_entities_ex, __VA_ARGS__);                   \
+		fn(ecsact_restore_entities_ex, __VA_ARGS__);                \
+		fn(ecsact_restore_as_execution_options_arena, __VA_ARGS__); \
+		fn(ecsact_serialize_component_max_size, __VA_ARGS__);       \
+		fn(ecsact_serialize_action_max_size, __VA_ARGS__);          \
+		fn(ecsact_serialize_component_ex, __VA_ARGS__);             \
+		fn(ecsact_deserialize_component_ex, __VA_ARGS__);           \
+		fn(ecsact_serialize_action_ex, __VA_ARGS__);                \
+		fn(ecsact_deserialize_action_ex, __VA_ARGS__)
 #endif
 
 #endif // ECSACT_RUNTIME_SERIALIZE_H
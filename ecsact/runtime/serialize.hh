@@ -85,6 +85,50 @@ ECSACT_ALWAYS_INLINE auto serialize( //
 	return out_action;
 }
 
+/**
+ * Serializes an ecsact_component with @p encoding.
+ * @returns serialized component bytes
+ */
+ECSACT_ALWAYS_INLINE auto serialize( //
+	const ecsact_component&   component,
+	ecsact_serialize_encoding encoding
+) -> std::vector<std::byte> {
+	std::vector<std::byte> out_component;
+	out_component.resize(
+		ecsact_serialize_component_max_size(component.component_id, encoding)
+	);
+	auto size = ecsact_serialize_component_ex(
+		component.component_id,
+		encoding,
+		component.component_data,
+		reinterpret_cast<uint8_t*>(out_component.data())
+	);
+	out_component.resize(size);
+	return out_component;
+}
+
+/**
+ * Serializes an ecsact_action with @p encoding.
+ * @returns serialized action bytes
+ */
+ECSACT_ALWAYS_INLINE auto serialize( //
+	const ecsact_action&      action,
+	ecsact_serialize_encoding encoding
+) -> std::vector<std::byte> {
+	std::vector<std::byte> out_action;
+	out_action.resize(
+		ecsact_serialize_action_max_size(action.action_id, encoding)
+	);
+	auto size = ecsact_serialize_action_ex(
+		action.action_id,
+		encoding,
+		action.action_data,
+		reinterpret_cast<uint8_t*>(out_action.data())
+	);
+	out_action.resize(size);
+	return out_action;
+}
+
 /**
  * Calls `ecsact_deserialize_action` or `ecsact_deserialize_component` based on
  * the type of @tp T.
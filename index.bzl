@@ -4,6 +4,7 @@ ecsact_runtime_modules = [
     "core",
     "dynamic",
     "meta",
+    "profile",
     "serialize",
     "static",
 ]
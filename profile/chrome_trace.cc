@@ -0,0 +1,329 @@
+#include "profile/chrome_trace.hh"
+
+#include <cinttypes>
+#include "ecsact/runtime/meta.h"
+
+using ecsact::profile::chrome_trace_writer;
+
+namespace {
+auto write_json_string(std::FILE* file, const std::string& str) -> void {
+	std::fputc('"', file);
+	for(auto c : str) {
+		switch(c) {
+			case '"':
+				std::fputs("\\\"", file);
+				break;
+			case '\\':
+				std::fputs("\\\\", file);
+				break;
+			case '\n':
+				std::fputs("\\n", file);
+				break;
+			default:
+				if(static_cast<unsigned char>(c) < 0x20) {
+					std::fprintf(file, "\\u%04x", c);
+				} else {
+					std::fputc(c, file);
+				}
+		}
+	}
+	std::fputc('"', file);
+}
+
+/**
+ * Chrome trace timestamps are in microseconds
+ */
+auto to_us(int64_t ns) -> double {
+	return static_cast<double>(ns) / 1000.0;
+}
+
+/**
+ * Process used for tick and flush markers. Registry IDs are never negative.
+ */
+constexpr auto async_pid = int32_t{-1};
+
+/**
+ * Threads of @ref async_pid
+ */
+constexpr auto tick_tid = int32_t{0};
+constexpr auto flush_tid = int32_t{1};
+} // namespace
+
+chrome_trace_writer::chrome_trace_writer(options opts)
+	: _options(std::move(opts)), _events(_options.ring_buffer_capacity) {
+	_file = std::fopen(_options.output_path.string().c_str(), "wb");
+	if(_file == nullptr) {
+		return;
+	}
+
+	std::fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", _file);
+	_writer_thread = std::thread([this] { write_loop(); });
+}
+
+chrome_trace_writer::~chrome_trace_writer() {
+	{
+		auto lk = std::scoped_lock{_stop_mutex};
+		_stop = true;
+	}
+	_stop_cv.notify_all();
+	if(_writer_thread.joinable()) {
+		_writer_thread.join();
+	}
+
+	if(_file != nullptr) {
+		std::fputs("\n]}\n", _file);
+		std::fclose(_file);
+	}
+}
+
+auto chrome_trace_writer::is_open() const noexcept -> bool {
+	return _file != nullptr;
+}
+
+auto chrome_trace_writer::collector() noexcept
+	-> ecsact_profile_events_collector {
+	auto evc = ecsact_profile_events_collector{};
+	evc.system_samples_callback = &chrome_trace_writer::samples_callback;
+	evc.system_samples_callback_user_data = this;
+	return evc;
+}
+
+auto chrome_trace_writer::push_samples(
+	ecsact_registry_id                            registry_id,
+	std::span<const ecsact_profile_system_sample> samples
+) noexcept -> void {
+	for(const auto& sample : samples) {
+		push_event(event{
+			.kind = event_kind::system_slice,
+			.registry_id = registry_id,
+			.tick = 0,
+			.sample = sample,
+		});
+	}
+}
+
+auto chrome_trace_writer::mark_tick(int32_t tick) noexcept -> void {
+	auto ev = event{
+		.kind = event_kind::tick,
+		.registry_id = {},
+		.tick = tick,
+		.sample = {},
+	};
+	ev.sample.start_ns = ecsact_profile_now();
+	push_event(ev);
+}
+
+auto chrome_trace_writer::mark_flush() noexcept -> void {
+	auto ev = event{
+		.kind = event_kind::flush,
+		.registry_id = {},
+		.tick = 0,
+		.sample = {},
+	};
+	ev.sample.start_ns = ecsact_profile_now();
+	push_event(ev);
+}
+
+auto chrome_trace_writer::dropped_count() const noexcept -> uint64_t {
+	return _dropped.load(std::memory_order_relaxed);
+}
+
+auto chrome_trace_writer::push_event(const event& ev) noexcept -> void {
+	if(!_events.try_push(ev)) {
+		_dropped.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+auto chrome_trace_writer::write_loop() -> void {
+	auto lk = std::unique_lock{_stop_mutex};
+	while(!_stop_cv.wait_for(lk, _options.flush_interval, [this] {
+		return _stop;
+	})) {
+		lk.unlock();
+		write_pending();
+		lk.lock();
+	}
+	lk.unlock();
+
+	write_pending();
+}
+
+auto chrome_trace_writer::write_pending() -> void {
+	auto written =
+		_events.consume([this](const event& ev) { write_event(ev); });
+	if(written > 0) {
+		std::fflush(_file);
+	}
+}
+
+auto chrome_trace_writer::begin_event() -> void {
+	if(!_first_event) {
+		std::fputc(',', _file);
+	}
+	std::fputc('\n', _file);
+	_first_event = false;
+}
+
+auto chrome_trace_writer::write_thread_name(
+	ecsact_registry_id registry_id,
+	int32_t            thread_index
+) -> void {
+	auto key = (static_cast<int64_t>(registry_id) << 32) | thread_index;
+	if(!_named_threads.insert(key).second) {
+		return;
+	}
+
+	begin_event();
+	std::fprintf(
+		_file,
+		"{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%" PRIi32
+		",\"tid\":%" PRIi32 ",\"args\":{\"name\":",
+		static_cast<int32_t>(registry_id),
+		thread_index
+	);
+	write_json_string(
+		_file,
+		thread_index == 0 ? std::string{"main"}
+											: "worker " + std::to_string(thread_index)
+	);
+	std::fputs("}}", _file);
+
+	if(thread_index == 0) {
+		auto registry_name = ecsact_meta_registry_name(registry_id);
+		begin_event();
+		std::fprintf(
+			_file,
+			"{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":%" PRIi32
+			",\"args\":{\"name\":",
+			static_cast<int32_t>(registry_id)
+		);
+		write_json_string(
+			_file,
+			registry_name != nullptr && registry_name[0] != '\0'
+				? std::string{registry_name}
+				: "registry " + std::to_string(static_cast<int32_t>(registry_id))
+		);
+		std::fputs("}}", _file);
+	}
+}
+
+auto chrome_trace_writer::write_async_process_name() -> void {
+	if(_named_async_process) {
+		return;
+	}
+	_named_async_process = true;
+
+	begin_event();
+	std::fprintf(
+		_file,
+		"{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":%" PRIi32
+		",\"args\":{\"name\":\"async\"}}",
+		async_pid
+	);
+
+	auto write_name = [this](int32_t tid, const char* name) {
+		begin_event();
+		std::fprintf(
+			_file,
+			"{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%" PRIi32
+			",\"tid\":%" PRIi32 ",\"args\":{\"name\":\"%s\"}}",
+			async_pid,
+			tid,
+			name
+		);
+	};
+	write_name(tick_tid, "ticks");
+	write_name(flush_tid, "flushes");
+}
+
+auto chrome_trace_writer::system_name( //
+	ecsact_system_like_id id
+) -> const std::string& {
+	auto key = static_cast<int32_t>(id);
+	auto itr = _system_names.find(key);
+	if(itr != _system_names.end()) {
+		return itr->second;
+	}
+
+	auto full_name =
+		ecsact_meta_decl_full_name(ecsact_id_cast<ecsact_decl_id>(id));
+	auto name = full_name != nullptr && full_name[0] != '\0'
+		? std::string{full_name}
+		: "system " + std::to_string(key);
+	return _system_names.emplace(key, std::move(name)).first->second;
+}
+
+auto chrome_trace_writer::write_marker(const event& ev) -> void {
+	write_async_process_name();
+	begin_event();
+	if(ev.kind == event_kind::tick) {
+		std::fprintf(
+			_file,
+			"{\"ph\":\"i\",\"s\":\"g\",\"name\":\"tick %" PRIi32
+			"\",\"cat\":\"tick\",\"pid\":%" PRIi32 ",\"tid\":%" PRIi32
+			",\"ts\":%.3f}",
+			ev.tick,
+			async_pid,
+			tick_tid,
+			to_us(ev.sample.start_ns)
+		);
+	} else {
+		std::fprintf(
+			_file,
+			"{\"ph\":\"i\",\"s\":\"t\",\"name\":\"flush\",\"cat\":\"flush\""
+			",\"pid\":%" PRIi32 ",\"tid\":%" PRIi32 ",\"ts\":%.3f}",
+			async_pid,
+			flush_tid,
+			to_us(ev.sample.start_ns)
+		);
+	}
+}
+
+auto chrome_trace_writer::write_event(const event& ev) -> void {
+	if(ev.kind != event_kind::system_slice) {
+		write_marker(ev);
+		return;
+	}
+
+	const auto& sample = ev.sample;
+	write_thread_name(ev.registry_id, sample.thread_index);
+
+	auto parent_id = ecsact_meta_get_parent_system_id(
+		static_cast<ecsact_system_id>(sample.system_like_id)
+	);
+
+	begin_event();
+	std::fputs("{\"ph\":\"X\",\"cat\":\"system\",\"name\":", _file);
+	write_json_string(_file, system_name(sample.system_like_id));
+	std::fprintf(
+		_file,
+		",\"pid\":%" PRIi32 ",\"tid\":%" PRIi32 ",\"ts\":%.3f,\"dur\":%.3f"
+		",\"args\":{\"execution\":%" PRIi64 ",\"entities\":%" PRIi32
+		",\"skipped\":%" PRIi32,
+		static_cast<int32_t>(ev.registry_id),
+		sample.thread_index,
+		to_us(sample.start_ns),
+		to_us(sample.duration_ns),
+		sample.execution_index,
+		sample.entities_iterated,
+		sample.entities_skipped
+	);
+	if(parent_id != ECSACT_INVALID_ID(system_like)) {
+		std::fputs(",\"parent\":", _file);
+		write_json_string(_file, system_name(parent_id));
+	}
+	std::fputs("}}", _file);
+}
+
+void chrome_trace_writer::samples_callback(
+	ecsact_registry_id                  registry_id,
+	int32_t                             samples_count,
+	const ecsact_profile_system_sample* samples,
+	void*                               callback_user_data
+) {
+	auto self = static_cast<chrome_trace_writer*>(callback_user_data);
+	self->push_samples(
+		registry_id,
+		std::span{samples, static_cast<size_t>(samples_count)}
+	);
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include "ecsact/mpsc_queue.hh"
+#include "ecsact/runtime/profile.h"
+
+namespace ecsact::profile {
+
+/**
+ * Writes profile samples as Chrome trace event JSON which can be opened with
+ * chrome://tracing or https://ui.perfetto.dev
+ *
+ * Each registry is written as a process and each worker thread as a thread.
+ * Every sample becomes a complete ('X') event so nested systems appear inside
+ * their parents slice. Tick and flush markers are written to their own
+ * "async" process so they never share a track with a registry.
+ *
+ * Samples are pushed into a fixed size lock-free ring buffer and written to
+ * the file by a background thread every @ref options::flush_interval. If the
+ * ring buffer is full the sample is dropped instead of blocking the caller.
+ * @see dropped_count
+ *
+ * System and registry names are looked up with the meta module on the
+ * background thread. The meta implementation must allow calls from any
+ * thread, and registries should not be destroyed while they still have
+ * samples in the ring buffer or their name falls back to their ID.
+ */
+class chrome_trace_writer {
+public:
+	struct options {
+		/**
+		 * Path of the trace file. Overwritten if it exists.
+		 */
+		std::filesystem::path output_path;
+
+		/**
+		 * Number of events the ring buffer can hold. Rounded up to a power of 2.
+		 */
+		size_t ring_buffer_capacity = 1 << 16;
+
+		/**
+		 * How often the background thread writes buffered events to the file.
+		 */
+		std::chrono::milliseconds flush_interval{100};
+	};
+
+	/**
+	 * Opens the trace file and starts the background writer thread. Check
+	 * @ref is_open to see if the file was opened successfully.
+	 */
+	chrome_trace_writer(options opts);
+	chrome_trace_writer(const chrome_trace_writer&) = delete;
+	chrome_trace_writer(chrome_trace_writer&&) = delete;
+
+	/**
+	 * Writes any remaining events and closes the trace file.
+	 */
+	~chrome_trace_writer();
+
+	auto is_open() const noexcept -> bool;
+
+	/**
+	 * Collector that forwards samples to this writer. Pass this to
+	 * `ecsact_profile_start`. The writer must outlive any registry using the
+	 * collector.
+	 */
+	auto collector() noexcept -> ecsact_profile_events_collector;
+
+	/**
+	 * Push samples into the ring buffer. Safe to call from any thread.
+	 */
+	auto push_samples(
+		ecsact_registry_id                            registry_id,
+		std::span<const ecsact_profile_system_sample> samples
+	) noexcept -> void;
+
+	/**
+	 * Records a global tick marker at the current time. Typically called with
+	 * the result of `ecsact_async_get_current_tick` once per frame. Safe to call
+	 * from any thread.
+	 */
+	auto mark_tick(int32_t tick) noexcept -> void;
+
+	/**
+	 * Records an async flush marker at the current time. Typically called right
+	 * after `ecsact_async_flush_events`. Safe to call from any thread.
+	 */
+	auto mark_flush() noexcept -> void;
+
+	/**
+	 * Number of events dropped because the ring buffer was full.
+	 */
+	auto dropped_count() const noexcept -> uint64_t;
+
+private:
+	enum class event_kind : int32_t {
+		system_slice,
+		tick,
+		flush,
+	};
+
+	struct event {
+		event_kind                   kind;
+		ecsact_registry_id           registry_id;
+		int32_t                      tick;
+		ecsact_profile_system_sample sample;
+	};
+
+	options                   _options;
+	bounded_mpsc_queue<event> _events;
+	std::FILE*                _file = nullptr;
+	bool                      _first_event = true;
+	std::thread               _writer_thread;
+	std::mutex                _stop_mutex;
+	std::condition_variable   _stop_cv;
+	bool                      _stop = false;
+	std::atomic<uint64_t>     _dropped = 0;
+
+	std::unordered_map<int32_t, std::string> _system_names;
+	std::unordered_set<int64_t>              _named_threads;
+	bool                                     _named_async_process = false;
+
+	auto push_event(const event& ev) noexcept -> void;
+	auto write_loop() -> void;
+	auto write_pending() -> void;
+	auto write_event(const event& ev) -> void;
+	auto write_marker(const event& ev) -> void;
+	auto write_thread_name(ecsact_registry_id, int32_t thread_index) -> void;
+	auto write_async_process_name() -> void;
+	auto system_name(ecsact_system_like_id) -> const std::string&;
+	auto begin_event() -> void;
+
+	static void samples_callback(
+		ecsact_registry_id                  registry_id,
+		int32_t                             samples_count,
+		const ecsact_profile_system_sample* samples,
+		void*                               callback_user_data
+	);
+};
+
+} // namespace ecsact::profile
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Binary layout of replay logs written by @ref ecsact::replay::recorder
+ *
+ * A log is a @ref file_header followed by records. Every record is a
+ * @ref record_header followed by `payload_size` bytes. Headers and counts are
+ * written in the native byte order of the recording machine so logs are only
+ * portable between machines of the same endianness. A log from the other
+ * endianness fails the @ref file_magic check. Components and actions are
+ * stored with `ecsact_serialize_component` and `ecsact_serialize_action`
+ * prefixed by their serialized size.
+ *
+ * Execution options payload:
+ *   i32 add count, then per add: entity, component
+ *   i32 update count, then per update: entity, component
+ *   i32 remove count, then per remove: entity, component ID
+ *   i32 action count, then per action: action
+ *   i32 create count, then per create: placeholder ID, i32 component count,
+ *       components
+ *   i32 destroy count, then per destroy: entity
+ *
+ * Stream payload: entity, component
+ *
+ * Keyframe payload: bytes from `ecsact_dump_entities`
+ *
+ * Index payload: @ref index_entry for every keyframe followed by an
+ * @ref index_footer at the very end of the file.
+ */
+namespace ecsact::replay::format {
+
+/**
+ * 'ECRP' when read on a little endian machine
+ */
+constexpr uint32_t file_magic = 0x50524345u;
+constexpr uint32_t file_version = 2;
+
+struct file_header {
+	uint32_t magic;
+	uint32_t version;
+
+	/**
+	 * `ecsact_meta_schema_hash` of the runtime that recorded the log
+	 */
+	uint64_t schema_hash;
+};
+
+enum class record_kind : uint32_t {
+	execution_options = 1,
+	stream = 2,
+	keyframe = 3,
+	index = 4,
+};
+
+struct record_header {
+	record_kind kind;
+	uint32_t    reserved;
+
+	/**
+	 * Tick the record was captured on. Ticks are assigned by the caller and
+	 * only need to be non-decreasing.
+	 */
+	int64_t tick;
+	int64_t payload_size;
+};
+
+struct index_entry {
+	int64_t tick;
+
+	/**
+	 * Byte offset of the keyframe @ref record_header from the file start
+	 */
+	int64_t offset;
+};
+
+struct index_footer {
+	/**
+	 * Byte offset of the index @ref record_header from the file start
+	 */
+	int64_t  index_offset;
+	uint32_t magic;
+	uint32_t reserved;
+};
+
+} // namespace ecsact::replay::format
@@ -0,0 +1,564 @@
+#include "replay/player.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include "ecsact/runtime/core.h"
+#include "ecsact/runtime/meta.hh"
+#include "ecsact/runtime/serialize.h"
+
+using ecsact::replay::player;
+namespace format = ecsact::replay::format;
+
+namespace {
+/**
+ * Reads values from a record payload. Once a read fails every following read
+ * returns zeroed values so decoding can finish without branching on every
+ * read and @ref error is checked once at the end.
+ */
+struct payload_reader {
+	std::span<const std::byte> data;
+	size_t                     pos = 0;
+	player::play_error         error = player::play_error::ok;
+
+	auto remaining() const noexcept -> size_t {
+		return data.size() - pos;
+	}
+
+	template<typename T>
+	auto read() -> T {
+		auto value = T{};
+		if(auto bytes = read_bytes(sizeof(T))) {
+			std::memcpy(&value, bytes, sizeof(T));
+		}
+		return value;
+	}
+
+	auto read_bytes(size_t size) -> const std::byte* {
+		if(error != player::play_error::ok) {
+			return nullptr;
+		}
+		if(size > remaining()) {
+			error = player::play_error::truncated_payload;
+			return nullptr;
+		}
+		auto bytes = data.data() + pos;
+		pos += size;
+		return bytes;
+	}
+
+	/**
+	 * Read an i32 list length. Every list entry takes at least 1 byte so a
+	 * length larger than the remaining payload is treated as truncated instead
+	 * of being trusted for a resize.
+	 */
+	auto read_length() -> size_t {
+		auto length = read<int32_t>();
+		if(length < 0 || static_cast<size_t>(length) > remaining()) {
+			if(error == player::play_error::ok) {
+				error = player::play_error::truncated_payload;
+			}
+			return 0;
+		}
+		return static_cast<size_t>(length);
+	}
+
+	/**
+	 * Read a serialized size prefix followed by that many bytes
+	 *
+	 * @returns `nullptr` if the size is not @p expected_size or the payload
+	 *          ends before the bytes
+	 */
+	auto read_serialized(int32_t expected_size) -> const std::byte* {
+		auto size = read<int32_t>();
+		if(error != player::play_error::ok) {
+			return nullptr;
+		}
+		if(size != expected_size) {
+			error = player::play_error::serialized_size_mismatch;
+			return nullptr;
+		}
+		return read_bytes(static_cast<size_t>(size));
+	}
+};
+
+struct restore_state {
+	std::span<const std::byte> data;
+	size_t                     pos = 0;
+};
+
+int32_t restore_callback(
+	void*   out_data,
+	int32_t data_max_length,
+	void*   callback_user_data
+) {
+	auto& state = *static_cast<restore_state*>(callback_user_data);
+	auto  read_length = std::min(
+		state.data.size() - state.pos,
+		static_cast<size_t>(data_max_length)
+	);
+	std::memcpy(out_data, state.data.data() + state.pos, read_length);
+	state.pos += read_length;
+	return static_cast<int32_t>(read_length);
+}
+
+auto align_up(size_t value, size_t alignment) -> size_t {
+	return (value + alignment - 1) & ~(alignment - 1);
+}
+
+/**
+ * Every decoded component is aligned to this in the arena
+ */
+constexpr auto arena_alignment = size_t{8};
+} // namespace
+
+player::player(const std::filesystem::path& log_path) {
+	auto file = std::ifstream{log_path, std::ios::binary | std::ios::ate};
+	if(!file) {
+		return;
+	}
+
+	_data.resize(static_cast<size_t>(file.tellg()));
+	file.seekg(0);
+	file.read(reinterpret_cast<char*>(_data.data()), _data.size());
+
+	auto header = format::file_header{};
+	if(_data.size() < sizeof(header) + sizeof(format::index_footer)) {
+		_data.clear();
+		return;
+	}
+
+	std::memcpy(&header, _data.data(), sizeof(header));
+	if(header.magic != format::file_magic ||
+		 header.version != format::file_version) {
+		_data.clear();
+		return;
+	}
+
+	_schema_hash = header.schema_hash;
+	_records_begin = sizeof(header);
+	_records_end = _data.size();
+	_pos = _records_begin;
+
+	auto footer = format::index_footer{};
+	std::memcpy(
+		&footer,
+		_data.data() + _data.size() - sizeof(footer),
+		sizeof(footer)
+	);
+
+	// A log without a footer was not closed properly. Every record up to the
+	// end of the file is still playable but there is no keyframe index.
+	if(footer.magic != format::file_magic) {
+		return;
+	}
+
+	auto footer_pos = _data.size() - sizeof(footer);
+	if(footer.index_offset < static_cast<int64_t>(_records_begin) ||
+		 footer.index_offset > static_cast<int64_t>(footer_pos)) {
+		return;
+	}
+
+	_records_end = static_cast<size_t>(footer.index_offset);
+	auto index_header = format::record_header{};
+	if(_records_end + sizeof(index_header) > footer_pos) {
+		return;
+	}
+
+	std::memcpy(
+		&index_header,
+		_data.data() + footer.index_offset,
+		sizeof(index_header)
+	);
+	auto index_size = static_cast<size_t>(std::clamp<int64_t>(
+		index_header.payload_size,
+		0,
+		footer_pos - _records_end - sizeof(index_header)
+	));
+	_index.resize(index_size / sizeof(format::index_entry));
+	if(!_index.empty()) {
+		std::memcpy(
+			_index.data(),
+			_data.data() + footer.index_offset + sizeof(index_header),
+			_index.size() * sizeof(format::index_entry)
+		);
+	}
+}
+
+auto player::is_open() const noexcept -> bool {
+	return !_data.empty();
+}
+
+auto player::schema_hash() const noexcept -> uint64_t {
+	return _schema_hash;
+}
+
+auto player::schema_matches() const -> bool {
+	return _schema_hash == ecsact_meta_schema_hash();
+}
+
+auto player::current_tick() const noexcept -> int64_t {
+	auto header = peek_header();
+	return header ? header->tick : 0;
+}
+
+auto player::keyframe_ticks() const -> std::vector<int64_t> {
+	auto ticks = std::vector<int64_t>{};
+	ticks.reserve(_index.size());
+	for(const auto& entry : _index) {
+		ticks.push_back(entry.tick);
+	}
+	return ticks;
+}
+
+auto player::last_error() const noexcept -> play_error {
+	return _error;
+}
+
+auto player::rewind() noexcept -> void {
+	_pos = _records_begin;
+	_error = play_error::ok;
+}
+
+auto player::seek(
+	ecsact_registry_id                       registry_id,
+	int64_t                                  tick,
+	const ecsact_execution_events_collector* events_collector
+) -> bool {
+	auto keyframe = std::find_if(
+		_index.rbegin(),
+		_index.rend(),
+		[&](const format::index_entry& entry) { return entry.tick <= tick; }
+	);
+
+	if(keyframe == _index.rend()) {
+		return false;
+	}
+
+	if(keyframe->offset < static_cast<int64_t>(_records_begin) ||
+		 keyframe->offset >= static_cast<int64_t>(_records_end)) {
+		return false;
+	}
+
+	_pos = static_cast<size_t>(keyframe->offset);
+	_error = play_error::ok;
+	auto header = peek_header();
+	if(!header || header->kind != format::record_kind::keyframe) {
+		return false;
+	}
+
+	if(!restore_keyframe(registry_id, payload(*header), events_collector)) {
+		return false;
+	}
+	_pos += sizeof(format::record_header) + header->payload_size;
+
+	while((header = peek_header()) && header->tick < tick) {
+		if(!step(registry_id, events_collector)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+auto player::step(
+	ecsact_registry_id                       registry_id,
+	const ecsact_execution_events_collector* events_collector
+) -> bool {
+	if(_error != play_error::ok) {
+		return false;
+	}
+
+	auto header = peek_header();
+	if(!header) {
+		if(_pos < _records_end) {
+			_error = play_error::truncated_record;
+		}
+		return false;
+	}
+
+	auto record_payload = payload(*header);
+
+	switch(header->kind) {
+		case format::record_kind::execution_options: {
+			auto exec_options = decode_execution_options(record_payload);
+			if(!exec_options) {
+				return false;
+			}
+			ecsact_execute_systems(registry_id, 1, &*exec_options, events_collector);
+			break;
+		}
+		case format::record_kind::stream: {
+			auto reader = payload_reader{record_payload};
+			auto entity = reader.read<ecsact_entity_id>();
+			auto component_id = reader.read<ecsact_component_id>();
+			auto serialized = reader.read_serialized(
+				ecsact_serialize_component_size(component_id)
+			);
+			if(reader.error != play_error::ok) {
+				_error = reader.error;
+				return false;
+			}
+
+			_arena.resize(composite_size(
+				ecsact_id_cast<ecsact_composite_id>(component_id)
+			));
+			ecsact_deserialize_component(
+				component_id,
+				reinterpret_cast<const uint8_t*>(serialized),
+				_arena.data()
+			);
+			ecsact_stream(registry_id, entity, component_id, _arena.data(), nullptr);
+			break;
+		}
+		case format::record_kind::keyframe:
+		case format::record_kind::index:
+			break;
+	}
+
+	_pos += sizeof(format::record_header) + header->payload_size;
+	return true;
+}
+
+auto player::play(
+	ecsact_registry_id                       registry_id,
+	const ecsact_execution_events_collector* events_collector
+) -> play_stats {
+	auto stats = play_stats{};
+	auto start = std::chrono::steady_clock::now();
+
+	for(;;) {
+		auto header = peek_header();
+		if(!step(registry_id, events_collector)) {
+			break;
+		}
+
+		if(header->kind == format::record_kind::execution_options) {
+			stats.executions += 1;
+		} else if(header->kind == format::record_kind::stream) {
+			stats.streams += 1;
+		}
+	}
+
+	stats.duration = std::chrono::steady_clock::now() - start;
+	stats.error = _error;
+	return stats;
+}
+
+auto player::peek_header() const -> std::optional<format::record_header> {
+	if(_pos + sizeof(format::record_header) > _records_end) {
+		return std::nullopt;
+	}
+
+	// Records follow payloads of any length so headers are not aligned
+	auto header = format::record_header{};
+	std::memcpy(&header, _data.data() + _pos, sizeof(header));
+
+	// A payload running past the last record means the log is truncated or
+	// corrupt. Stop playing instead of reading past it.
+	auto payload_end = _pos + sizeof(header);
+	if(header.payload_size < 0 ||
+		 static_cast<size_t>(header.payload_size) > _records_end - payload_end) {
+		return std::nullopt;
+	}
+
+	return header;
+}
+
+auto player::payload(const format::record_header& header) const
+	-> std::span<const std::byte> {
+	auto payload_begin = _data.data() + _pos + sizeof(header);
+	return {payload_begin, static_cast<size_t>(header.payload_size)};
+}
+
+auto player::decode_execution_options( //
+	std::span<const std::byte> payload
+) -> std::optional<ecsact_execution_options> {
+	auto reader = payload_reader{payload};
+	auto arena_size = size_t{};
+
+	_pending.clear();
+
+	// Component data pointers temporarily hold the arena offset until every
+	// size is known and the arena can be resized once
+	auto read_composite = [&](int32_t composite_id, bool is_action) -> void* {
+		auto expected_size = int32_t{};
+		if(is_action) {
+			expected_size = ecsact_serialize_action_size( //
+				static_cast<ecsact_action_id>(composite_id)
+			);
+		} else {
+			expected_size = ecsact_serialize_component_size( //
+				static_cast<ecsact_component_id>(composite_id)
+			);
+		}
+
+		auto serialized = reader.read_serialized(expected_size);
+		if(serialized == nullptr) {
+			return nullptr;
+		}
+
+		auto arena_offset = align_up(arena_size, arena_alignment);
+		_pending.push_back(pending_data{
+			.composite_id = composite_id,
+			.is_action = is_action,
+			.serialized = serialized,
+			.arena_offset = arena_offset,
+		});
+		arena_size = arena_offset +
+			composite_size(static_cast<ecsact_composite_id>(composite_id));
+		return reinterpret_cast<void*>(arena_offset);
+	};
+
+	auto read_component = [&]() -> ecsact_component {
+		auto component_id = reader.read<ecsact_component_id>();
+		return ecsact_component{
+			.component_id = component_id,
+			.component_data =
+				read_composite(static_cast<int32_t>(component_id), false),
+		};
+	};
+
+	_add_entities.resize(reader.read_length());
+	_add_components.resize(_add_entities.size());
+	for(size_t i = 0; _add_entities.size() > i; ++i) {
+		_add_entities[i] = reader.read<ecsact_entity_id>();
+		_add_components[i] = read_component();
+	}
+
+	_update_entities.resize(reader.read_length());
+	_update_components.resize(_update_entities.size());
+	for(size_t i = 0; _update_entities.size() > i; ++i) {
+		_update_entities[i] = reader.read<ecsact_entity_id>();
+		_update_components[i] = read_component();
+	}
+
+	_remove_entities.resize(reader.read_length());
+	_remove_components.resize(_remove_entities.size());
+	for(size_t i = 0; _remove_entities.size() > i; ++i) {
+		_remove_entities[i] = reader.read<ecsact_entity_id>();
+		_remove_components[i] = reader.read<ecsact_component_id>();
+	}
+
+	_actions.resize(reader.read_length());
+	for(auto& action : _actions) {
+		action.action_id = reader.read<ecsact_action_id>();
+		action.action_data =
+			read_composite(static_cast<int32_t>(action.action_id), true);
+	}
+
+	_create_entities.resize(reader.read_length());
+	_create_components_length.resize(_create_entities.size());
+	_create_components.clear();
+	for(size_t i = 0; _create_entities.size() > i; ++i) {
+		_create_entities[i] = reader.read<ecsact_placeholder_entity_id>();
+		_create_components_length[i] = static_cast<int>(reader.read_length());
+		for(auto c = 0; _create_components_length[i] > c; ++c) {
+			_create_components.push_back(read_component());
+		}
+	}
+
+	_destroy_entities.resize(reader.read_length());
+	for(auto& entity : _destroy_entities) {
+		entity = reader.read<ecsact_entity_id>();
+	}
+
+	if(reader.error != play_error::ok) {
+		_error = reader.error;
+		return std::nullopt;
+	}
+
+	_arena.resize(arena_size);
+	for(const auto& pending : _pending) {
+		auto out_data = _arena.data() + pending.arena_offset;
+		auto in_bytes = reinterpret_cast<const uint8_t*>(pending.serialized);
+		if(pending.is_action) {
+			ecsact_deserialize_action(
+				static_cast<ecsact_action_id>(pending.composite_id),
+				in_bytes,
+				out_data
+			);
+		} else {
+			ecsact_deserialize_component(
+				static_cast<ecsact_component_id>(pending.composite_id),
+				in_bytes,
+				out_data
+			);
+		}
+	}
+
+	auto relocate = [this](const void*& data) {
+		data = _arena.data() + reinterpret_cast<uintptr_t>(data);
+	};
+
+	for(auto& comp : _add_components) {
+		relocate(comp.component_data);
+	}
+	for(auto& comp : _update_components) {
+		relocate(comp.component_data);
+	}
+	for(auto& comp : _create_components) {
+		relocate(comp.component_data);
+	}
+	for(auto& action : _actions) {
+		relocate(action.action_data);
+	}
+
+	_create_components_lists.resize(_create_entities.size());
+	auto create_components_data = _create_components.data();
+	for(size_t i = 0; _create_entities.size() > i; ++i) {
+		_create_components_lists[i] = create_components_data;
+		create_components_data += _create_components_length[i];
+	}
+
+	auto exec_options = ecsact_execution_options{};
+	exec_options.add_components_length = static_cast<int>(_add_entities.size());
+	exec_options.add_components_entities = _add_entities.data();
+	exec_options.add_components = _add_components.data();
+	exec_options.update_components_length =
+		static_cast<int>(_update_entities.size());
+	exec_options.update_components_entities = _update_entities.data();
+	exec_options.update_components = _update_components.data();
+	exec_options.remove_components_length =
+		static_cast<int>(_remove_entities.size());
+	exec_options.remove_components_entities = _remove_entities.data();
+	exec_options.remove_components = _remove_components.data();
+	exec_options.actions_length = static_cast<int>(_actions.size());
+	exec_options.actions = _actions.data();
+	exec_options.create_entities_length =
+		static_cast<int>(_create_entities.size());
+	exec_options.create_entities = _create_entities.data();
+	exec_options.create_entities_components_length =
+		_create_components_length.data();
+	exec_options.create_entities_components = _create_components_lists.data();
+	exec_options.destroy_entities_length =
+		static_cast<int>(_destroy_entities.size());
+	exec_options.destroy_entities = _destroy_entities.data();
+	return exec_options;
+}
+
+auto player::composite_size(ecsact_composite_id id) -> size_t {
+	auto key = static_cast<int32_t>(id);
+	if(auto itr = _composite_sizes.find(key); itr != _composite_sizes.end()) {
+		return itr->second;
+	}
+
+	auto size = ecsact::meta::composite_size(id);
+	_composite_sizes.emplace(key, size);
+	return size;
+}
+
+auto player::restore_keyframe(
+	ecsact_registry_id                       registry_id,
+	std::span<const std::byte>               payload,
+	const ecsact_execution_events_collector* events_collector
+) -> bool {
+	auto state = restore_state{payload};
+	auto err = ecsact_restore_entities(
+		registry_id,
+		&restore_callback,
+		events_collector,
+		&state
+	);
+	return err == ECSACT_RESTORE_OK;
+}
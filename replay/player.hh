@@ -0,0 +1,199 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+#include "ecsact/runtime/common.h"
+#include "replay/format.hh"
+
+namespace ecsact::replay {
+
+/**
+ * Plays back a replay log written by @ref recorder into a registry.
+ *
+ * The whole log is read into memory when constructed. Records are decoded
+ * into storage owned by the player which is reused between records so
+ * playback does not allocate once warmed up.
+ */
+class player {
+public:
+	/**
+	 * Why playback stopped before the end of the records
+	 */
+	enum class play_error {
+		ok,
+
+		/**
+		 * A record header or payload runs past the end of the records
+		 */
+		truncated_record,
+
+		/**
+		 * A record payload ends before every value it declares
+		 */
+		truncated_payload,
+
+		/**
+		 * A serialized component or action size differs from the size the loaded
+		 * runtime serializes it with
+		 */
+		serialized_size_mismatch,
+	};
+
+	struct play_stats {
+		int64_t                  executions = 0;
+		int64_t                  streams = 0;
+		std::chrono::nanoseconds duration{};
+		play_error               error = play_error::ok;
+	};
+
+	player(const std::filesystem::path& log_path);
+
+	/**
+	 * @returns `true` if the log was read and has a valid header
+	 */
+	auto is_open() const noexcept -> bool;
+
+	/**
+	 * `ecsact_meta_schema_hash` of the runtime that recorded the log
+	 */
+	auto schema_hash() const noexcept -> uint64_t;
+
+	/**
+	 * @returns `true` if the log was recorded with the same schema as the
+	 *          loaded runtime. Logs with a different schema still play back
+	 *          since components are deserialized by field, but keyframes may fail
+	 *          to restore.
+	 */
+	auto schema_matches() const -> bool;
+
+	/**
+	 * Tick of the next record to be played
+	 */
+	auto current_tick() const noexcept -> int64_t;
+
+	/**
+	 * Ticks of every keyframe in the log in the order they were recorded
+	 */
+	auto keyframe_ticks() const -> std::vector<int64_t>;
+
+	/**
+	 * Why the last @ref step, @ref seek or @ref play stopped early. Records are
+	 * never played past an error until @ref rewind or @ref seek.
+	 */
+	auto last_error() const noexcept -> play_error;
+
+	/**
+	 * Move back to the first record and clear @ref last_error
+	 */
+	auto rewind() noexcept -> void;
+
+	/**
+	 * Restores @p registry_id from the closest keyframe at or before @p tick and
+	 * plays every record after it up to, but not including, @p tick.
+	 *
+	 * @returns `false` if there is no keyframe at or before @p tick or a record
+	 *          before @p tick is corrupt (@see last_error)
+	 */
+	auto seek(
+		ecsact_registry_id                       registry_id,
+		int64_t                                  tick,
+		const ecsact_execution_events_collector* events_collector = nullptr
+	) -> bool;
+
+	/**
+	 * Plays the next record. Execution options are executed with
+	 * `ecsact_execute_systems` and stream data is sent with `ecsact_stream`.
+	 * Keyframes are skipped. Every read is bounds checked against the record
+	 * so a corrupt record is not played and stops playback instead.
+	 *
+	 * @returns `false` when there are no more records or the next record is
+	 *          corrupt (@see last_error)
+	 */
+	auto step(
+		ecsact_registry_id                       registry_id,
+		const ecsact_execution_events_collector* events_collector = nullptr
+	) -> bool;
+
+	/**
+	 * Plays every remaining record as fast as possible until the end of the
+	 * records or the first corrupt record
+	 */
+	auto play(
+		ecsact_registry_id                       registry_id,
+		const ecsact_execution_events_collector* events_collector = nullptr
+	) -> play_stats;
+
+private:
+	std::vector<std::byte>           _data;
+	uint64_t                         _schema_hash = 0;
+	size_t                           _records_begin = 0;
+	size_t                           _records_end = 0;
+	size_t                           _pos = 0;
+	play_error                       _error = play_error::ok;
+	std::vector<format::index_entry> _index;
+
+	/**
+	 * Deserialized component and action data. Pointers in the decoded lists
+	 * below point into this.
+	 */
+	std::vector<std::byte> _arena;
+
+	std::vector<ecsact_entity_id>             _add_entities;
+	std::vector<ecsact_component>             _add_components;
+	std::vector<ecsact_entity_id>             _update_entities;
+	std::vector<ecsact_component>             _update_components;
+	std::vector<ecsact_entity_id>             _remove_entities;
+	std::vector<ecsact_component_id>          _remove_components;
+	std::vector<ecsact_action>                _actions;
+	std::vector<ecsact_placeholder_entity_id> _create_entities;
+	std::vector<int>                          _create_components_length;
+	std::vector<ecsact_component>             _create_components;
+	std::vector<ecsact_component*>            _create_components_lists;
+	std::vector<ecsact_entity_id>             _destroy_entities;
+
+	/**
+	 * Serialized component or action waiting to be deserialized into the arena
+	 */
+	struct pending_data {
+		int32_t          composite_id;
+		bool             is_action;
+		const std::byte* serialized;
+		size_t           arena_offset;
+	};
+
+	std::vector<pending_data>           _pending;
+	std::unordered_map<int32_t, size_t> _composite_sizes;
+
+	/**
+	 * Header of the record at the current position or `std::nullopt` at the
+	 * end of the records or when the record's payload does not fit
+	 */
+	auto peek_header() const -> std::optional<format::record_header>;
+
+	/**
+	 * Payload of the record at the current position
+	 */
+	auto payload(const format::record_header& header) const
+		-> std::span<const std::byte>;
+
+	/**
+	 * @returns `std::nullopt` and sets @ref _error if @p payload is corrupt
+	 */
+	auto decode_execution_options( //
+		std::span<const std::byte> payload
+	) -> std::optional<ecsact_execution_options>;
+	auto composite_size(ecsact_composite_id id) -> size_t;
+	auto restore_keyframe(
+		ecsact_registry_id                       registry_id,
+		std::span<const std::byte>               payload,
+		const ecsact_execution_events_collector* events_collector
+	) -> bool;
+};
+
+} // namespace ecsact::replay
@@ -0,0 +1,227 @@
+#include "replay/recorder.hh"
+
+#include <cstring>
+#include "ecsact/runtime/meta.h"
+#include "ecsact/runtime/serialize.h"
+
+using ecsact::replay::recorder;
+namespace format = ecsact::replay::format;
+
+recorder::recorder(options opts) : _options(std::move(opts)) {
+	_buffer.reserve(_options.write_buffer_size);
+	_file = std::fopen(_options.output_path.string().c_str(), "wb");
+	if(_file == nullptr) {
+		return;
+	}
+
+	append(format::file_header{
+		.magic = format::file_magic,
+		.version = format::file_version,
+		.schema_hash = ecsact_meta_schema_hash(),
+	});
+}
+
+recorder::~recorder() {
+	if(_file == nullptr) {
+		return;
+	}
+
+	auto index_offset = offset();
+	auto header_pos = begin_record(format::record_kind::index, 0);
+	append(_index.data(), _index.size() * sizeof(format::index_entry));
+	end_record(header_pos);
+
+	append(format::index_footer{
+		.index_offset = index_offset,
+		.magic = format::file_magic,
+		.reserved = 0,
+	});
+
+	flush();
+	std::fclose(_file);
+}
+
+auto recorder::is_open() const noexcept -> bool {
+	return _file != nullptr;
+}
+
+auto recorder::record_execution_options(
+	ecsact_registry_id              registry_id,
+	int64_t                         tick,
+	const ecsact_execution_options& exec_options
+) -> void {
+	if(_file == nullptr) {
+		return;
+	}
+
+	if(_options.keyframe_interval > 0) {
+		if(!_has_keyframe ||
+			 tick - _last_keyframe_tick >= _options.keyframe_interval) {
+			record_keyframe(registry_id, tick);
+		}
+	}
+
+	auto header_pos = begin_record(format::record_kind::execution_options, tick);
+
+	append(static_cast<int32_t>(exec_options.add_components_length));
+	for(auto i = 0; exec_options.add_components_length > i; ++i) {
+		append(exec_options.add_components_entities[i]);
+		append_component(exec_options.add_components[i]);
+	}
+
+	append(static_cast<int32_t>(exec_options.update_components_length));
+	for(auto i = 0; exec_options.update_components_length > i; ++i) {
+		append(exec_options.update_components_entities[i]);
+		append_component(exec_options.update_components[i]);
+	}
+
+	append(static_cast<int32_t>(exec_options.remove_components_length));
+	for(auto i = 0; exec_options.remove_components_length > i; ++i) {
+		append(exec_options.remove_components_entities[i]);
+		append(exec_options.remove_components[i]);
+	}
+
+	append(static_cast<int32_t>(exec_options.actions_length));
+	for(auto i = 0; exec_options.actions_length > i; ++i) {
+		append_action(exec_options.actions[i]);
+	}
+
+	append(static_cast<int32_t>(exec_options.create_entities_length));
+	for(auto i = 0; exec_options.create_entities_length > i; ++i) {
+		auto components_length = exec_options.create_entities_components_length[i];
+		append(exec_options.create_entities[i]);
+		append(static_cast<int32_t>(components_length));
+		for(auto c = 0; components_length > c; ++c) {
+			append_component(exec_options.create_entities_components[i][c]);
+		}
+	}
+
+	append(static_cast<int32_t>(exec_options.destroy_entities_length));
+	for(auto i = 0; exec_options.destroy_entities_length > i; ++i) {
+		append(exec_options.destroy_entities[i]);
+	}
+
+	end_record(header_pos);
+}
+
+auto recorder::record_stream(
+	int64_t             tick,
+	ecsact_entity_id    entity,
+	ecsact_component_id component_id,
+	const void*         component_data
+) -> void {
+	if(_file == nullptr) {
+		return;
+	}
+
+	auto header_pos = begin_record(format::record_kind::stream, tick);
+	append(entity);
+	append_component(ecsact_component{component_id, component_data});
+	end_record(header_pos);
+}
+
+auto recorder::record_keyframe( //
+	ecsact_registry_id registry_id,
+	int64_t            tick
+) -> void {
+	if(_file == nullptr) {
+		return;
+	}
+
+	_index.push_back(format::index_entry{.tick = tick, .offset = offset()});
+	_last_keyframe_tick = tick;
+	_has_keyframe = true;
+
+	auto header_pos = begin_record(format::record_kind::keyframe, tick);
+	ecsact_dump_entities(registry_id, &recorder::dump_callback, this);
+	end_record(header_pos);
+}
+
+auto recorder::flush() -> void {
+	if(_file == nullptr || _buffer.empty()) {
+		return;
+	}
+
+	std::fwrite(_buffer.data(), 1, _buffer.size(), _file);
+	std::fflush(_file);
+	_flushed_size += static_cast<int64_t>(_buffer.size());
+	_buffer.clear();
+}
+
+auto recorder::offset() const noexcept -> int64_t {
+	return _flushed_size + static_cast<int64_t>(_buffer.size());
+}
+
+auto recorder::begin_record( //
+	format::record_kind kind,
+	int64_t             tick
+) -> size_t {
+	// Records are kept whole in the buffer so the header can be patched with
+	// the payload size in end_record
+	if(_buffer.size() >= _options.write_buffer_size) {
+		flush();
+	}
+
+	auto header_pos = _buffer.size();
+	append(format::record_header{
+		.kind = kind,
+		.reserved = 0,
+		.tick = tick,
+		.payload_size = 0,
+	});
+	return header_pos;
+}
+
+auto recorder::end_record(size_t header_pos) -> void {
+	auto payload_size = static_cast<int64_t>(
+		_buffer.size() - header_pos - sizeof(format::record_header)
+	);
+	std::memcpy(
+		_buffer.data() + header_pos + offsetof(format::record_header, payload_size),
+		&payload_size,
+		sizeof(payload_size)
+	);
+}
+
+auto recorder::reserve(size_t size) -> std::byte* {
+	auto pos = _buffer.size();
+	_buffer.resize(pos + size);
+	return _buffer.data() + pos;
+}
+
+auto recorder::append(const void* data, size_t size) -> void {
+	if(size > 0) {
+		std::memcpy(reserve(size), data, size);
+	}
+}
+
+auto recorder::append_component(const ecsact_component& component) -> void {
+	auto size = ecsact_serialize_component_size(component.component_id);
+	append(component.component_id);
+	append(static_cast<int32_t>(size));
+	ecsact_serialize_component(
+		component.component_id,
+		component.component_data,
+		reinterpret_cast<uint8_t*>(reserve(size))
+	);
+}
+
+auto recorder::append_action(const ecsact_action& action) -> void {
+	auto size = ecsact_serialize_action_size(action.action_id);
+	append(action.action_id);
+	append(static_cast<int32_t>(size));
+	ecsact_serialize_action(
+		action.action_id,
+		action.action_data,
+		reinterpret_cast<uint8_t*>(reserve(size))
+	);
+}
+
+void recorder::dump_callback(
+	const void* data,
+	int32_t     data_length,
+	void*       callback_user_data
+) {
+	auto self = static_cast<recorder*>(callback_user_data);
+	self->append(data, static_cast<size_t>(data_length));
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <vector>
+#include "ecsact/runtime/common.h"
+#include "replay/format.hh"
+
+namespace ecsact::replay {
+
+/**
+ * Records execution options and stream data into an append-only replay log
+ * (@see format.hh) that can be played back with @ref player.
+ *
+ * Records are serialized straight into an in-memory write buffer which is
+ * appended to the file when full or on @ref flush. Not thread safe.
+ */
+class recorder {
+public:
+	struct options {
+		/**
+		 * Path of the replay log. Overwritten if it exists.
+		 */
+		std::filesystem::path output_path;
+
+		/**
+		 * Automatically record a keyframe every N ticks in
+		 * @ref record_execution_options. `0` only records keyframes when
+		 * @ref record_keyframe is called.
+		 */
+		int64_t keyframe_interval = 0;
+
+		/**
+		 * Bytes buffered before the buffer is appended to the file
+		 */
+		size_t write_buffer_size = 1 << 20;
+	};
+
+	recorder(options opts);
+	recorder(const recorder&) = delete;
+	recorder(recorder&&) = delete;
+
+	/**
+	 * Writes the keyframe index and closes the log
+	 */
+	~recorder();
+
+	/**
+	 * @returns `false` if the log could not be opened. Every record function
+	 *          does nothing in that case so nothing is buffered.
+	 */
+	auto is_open() const noexcept -> bool;
+
+	/**
+	 * Record the execution options for @p tick. Call with the same options
+	 * passed to `ecsact_execute_systems` or
+	 * `ecsact_async_enqueue_execution_options`.
+	 *
+	 * @param registry_id used for automatic keyframes. Keyframes are recorded
+	 *        before the options so they represent the registry at the start of
+	 *        @p tick.
+	 *
+	 * NOTE: indexed field values are not recorded
+	 */
+	auto record_execution_options(
+		ecsact_registry_id              registry_id,
+		int64_t                         tick,
+		const ecsact_execution_options& exec_options
+	) -> void;
+
+	/**
+	 * Record a call to `ecsact_stream` or `ecsact_async_stream`
+	 */
+	auto record_stream(
+		int64_t             tick,
+		ecsact_entity_id    entity,
+		ecsact_component_id component_id,
+		const void*         component_data
+	) -> void;
+
+	/**
+	 * Record the entire state of @p registry_id with `ecsact_dump_entities`.
+	 * Players seek to the closest keyframe before the requested tick.
+	 */
+	auto record_keyframe(ecsact_registry_id registry_id, int64_t tick) -> void;
+
+	/**
+	 * Append buffered records to the file
+	 */
+	auto flush() -> void;
+
+private:
+	options                          _options;
+	std::FILE*                       _file = nullptr;
+	std::vector<std::byte>           _buffer;
+	int64_t                          _flushed_size = 0;
+	std::vector<format::index_entry> _index;
+	int64_t                          _last_keyframe_tick = 0;
+	bool                             _has_keyframe = false;
+
+	auto offset() const noexcept -> int64_t;
+	auto begin_record(format::record_kind kind, int64_t tick) -> size_t;
+	auto end_record(size_t header_pos) -> void;
+	auto reserve(size_t size) -> std::byte*;
+	auto append(const void* data, size_t size) -> void;
+	auto append_component(const ecsact_component& component) -> void;
+	auto append_action(const ecsact_action& action) -> void;
+
+	template<typename T>
+	auto append(const T& value) -> void {
+		append(&value, sizeof(T));
+	}
+
+	static void dump_callback(
+		const void* data,
+		int32_t     data_length,
+		void*       callback_user_data
+	);
+};
+
+} // namespace ecsact::replay
@@ -0,0 +1,201 @@
+/**
+ * Measures enqueuing execution options from many producer threads at once
+ * with the lock-free @ref ecsact::async_local::execution_options_queue
+ * compared to deep copying into a mutex guarded list. A single consumer thread
+ * drains the queue for the whole run like an async session's execution thread.
+ */
+
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "benchmark/benchmark.h"
+#include "async_local/execution_options_queue.hh"
+
+using ecsact::async_local::execution_options_queue;
+
+namespace {
+
+struct position {
+	float x;
+	float y;
+	float z;
+	float w;
+};
+
+struct move_action {
+	int32_t dx;
+	int32_t dy;
+};
+
+constexpr auto position_id = static_cast<ecsact_component_id>(1);
+constexpr auto move_action_id = static_cast<ecsact_action_id>(2);
+constexpr auto update_count = 4;
+
+struct sample_options {
+	ecsact_entity_id         entities[update_count];
+	position                 positions[update_count];
+	ecsact_component         components[update_count];
+	move_action              move;
+	ecsact_action            action;
+	ecsact_execution_options options;
+
+	sample_options() : options{} {
+		for(auto i = 0; update_count > i; ++i) {
+			entities[i] = static_cast<ecsact_entity_id>(i);
+			positions[i] = position{1.f, 2.f, 3.f, 4.f};
+			components[i] = ecsact_component{position_id, &positions[i]};
+		}
+		move = move_action{1, -1};
+		action = ecsact_action{move_action_id, &move};
+		options.update_components_length = update_count;
+		options.update_components_entities = entities;
+		options.update_components = components;
+		options.actions_length = 1;
+		options.actions = &action;
+	}
+};
+
+/**
+ * Single consumer draining @p drain until stopped
+ */
+template<typename Drain>
+class consumer_thread {
+public:
+	consumer_thread(Drain drain) : _thread([this, drain] {
+		while(!_stop.load(std::memory_order_acquire)) {
+			if(drain() == 0) {
+				std::this_thread::yield();
+			}
+		}
+		drain();
+	}) {
+	}
+
+	~consumer_thread() {
+		_stop.store(true, std::memory_order_release);
+		_thread.join();
+	}
+
+private:
+	std::atomic_bool _stop = false;
+	std::thread      _thread;
+};
+
+auto make_queue() -> execution_options_queue* {
+	auto opts = execution_options_queue::options{};
+	opts.slot_count = 1 << 16;
+	opts.slab_size = 512;
+	opts.composite_sizes[static_cast<int32_t>(position_id)] = sizeof(position);
+	opts.composite_sizes[static_cast<int32_t>(move_action_id)] =
+		sizeof(move_action);
+	return new execution_options_queue(std::move(opts));
+}
+
+execution_options_queue* queue = nullptr;
+
+auto queue_drain = [] {
+	return queue->consume([](ecsact_async_request_id, const auto& options) {
+		benchmark::DoNotOptimize(options.update_components_length);
+	});
+};
+
+std::unique_ptr<consumer_thread<decltype(queue_drain)>> queue_consumer;
+
+void BM_EnqueueLockFree(benchmark::State& state) {
+	if(state.thread_index() == 0) {
+		queue = make_queue();
+		queue_consumer = std::make_unique<consumer_thread<decltype(queue_drain)>>(
+			queue_drain
+		);
+	}
+
+	auto sample = sample_options{};
+	auto full_count = int64_t{};
+	for(auto _ : state) {
+		auto result = queue->push(sample.options);
+		if(result.error != ECSACT_ASYNC_OK) {
+			full_count += 1;
+		}
+		benchmark::DoNotOptimize(result.request_id);
+	}
+
+	state.counters["full"] =
+		benchmark::Counter(full_count, benchmark::Counter::kAvgThreads);
+	state.SetItemsProcessed(state.iterations());
+
+	if(state.thread_index() == 0) {
+		queue_consumer.reset();
+		delete queue;
+	}
+}
+
+BENCHMARK(BM_EnqueueLockFree)->ThreadRange(1, 8)->UseRealTime();
+
+/**
+ * What callers do today: deep copy under a mutex shared with the consumer
+ */
+std::mutex                          locked_mutex;
+std::vector<std::vector<std::byte>> locked_list;
+std::vector<std::vector<std::byte>> locked_drained;
+int32_t                             locked_next_id = 0;
+
+auto locked_drain = [] {
+	{
+		auto lk = std::scoped_lock{locked_mutex};
+		locked_drained.swap(locked_list);
+	}
+	auto count = locked_drained.size();
+	locked_drained.clear();
+	return count;
+};
+
+std::unique_ptr<consumer_thread<decltype(locked_drain)>> locked_consumer;
+
+auto locked_push(const ecsact_execution_options& options)
+	-> ecsact_async_request_id {
+	auto bytes = std::vector<std::byte>{};
+	auto append = [&](const void* data, size_t size) {
+		auto pos = bytes.size();
+		bytes.resize(pos + size);
+		std::memcpy(bytes.data() + pos, data, size);
+	};
+
+	append(&options, sizeof(options));
+	for(auto i = 0; options.update_components_length > i; ++i) {
+		append(&options.update_components_entities[i], sizeof(ecsact_entity_id));
+		append(&options.update_components[i], sizeof(ecsact_component));
+		append(options.update_components[i].component_data, sizeof(position));
+	}
+	for(auto i = 0; options.actions_length > i; ++i) {
+		append(&options.actions[i], sizeof(ecsact_action));
+		append(options.actions[i].action_data, sizeof(move_action));
+	}
+
+	auto lk = std::scoped_lock{locked_mutex};
+	locked_list.emplace_back(std::move(bytes));
+	return static_cast<ecsact_async_request_id>(locked_next_id++);
+}
+
+void BM_EnqueueMutex(benchmark::State& state) {
+	if(state.thread_index() == 0) {
+		locked_consumer =
+			std::make_unique<consumer_thread<decltype(locked_drain)>>(locked_drain);
+	}
+
+	auto sample = sample_options{};
+	for(auto _ : state) {
+		benchmark::DoNotOptimize(locked_push(sample.options));
+	}
+
+	state.SetItemsProcessed(state.iterations());
+
+	if(state.thread_index() == 0) {
+		locked_consumer.reset();
+	}
+}
+
+BENCHMARK(BM_EnqueueMutex)->ThreadRange(1, 8)->UseRealTime();
+
+} // namespace
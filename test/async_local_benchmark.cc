@@ -0,0 +1,117 @@
+/**
+ * Measures the round trip of execution options through the local async module
+ * from `ecsact_async_enqueue_execution_options` until their request is
+ * reported done by `ecsact_async_flush_events`. The core module is a fake
+ * that only invokes event callbacks so the async overhead dominates.
+ */
+
+#include <vector>
+#include "benchmark/benchmark.h"
+#include "ecsact/runtime/async.h"
+#include "async_local_fake_runtime.hh"
+
+using ecsact::test::fake_position;
+using ecsact::test::fake_position_id;
+
+namespace {
+
+struct round_trip_state {
+	ecsact_async_request_id last_request_id;
+	bool                    last_done;
+	int64_t                 update_events;
+};
+
+auto start_session(ecsact_async_pacing pacing) -> ecsact_async_session_id {
+	auto options = ecsact_async_tick_options{};
+	options.magic = ECSACT_ASYNC_TICK_OPTIONS_MAGIC;
+	options.struct_size = sizeof(options);
+	options.tick_rate_hz = 1000;
+	options.pacing = pacing;
+	return ecsact_async_start(&options, sizeof(options));
+}
+
+/**
+ * Range 0: requests enqueued per round trip
+ * Range 1: @ref ecsact_async_coalesce_policy
+ */
+void BM_RoundTrip(benchmark::State& state) {
+	auto requests_count = static_cast<int32_t>(state.range(0));
+	auto policy = static_cast<ecsact_async_coalesce_policy>(state.range(1));
+	auto session_id = start_session(ECSACT_ASYNC_PACING_HYBRID);
+	ecsact_async_set_coalesce_policy(session_id, policy);
+
+	auto entities = std::vector<ecsact_entity_id>{};
+	auto positions = std::vector<fake_position>{};
+	auto components = std::vector<ecsact_component>{};
+	entities.resize(requests_count);
+	positions.resize(requests_count);
+	components.resize(requests_count);
+	for(auto i = 0; requests_count > i; ++i) {
+		entities[i] = static_cast<ecsact_entity_id>(i);
+		positions[i] = fake_position{i};
+		components[i] = ecsact_component{fake_position_id, &positions[i]};
+	}
+
+	auto rt = round_trip_state{};
+	auto evc = ecsact_execution_events_collector{};
+	evc.update_callback = //
+		[](
+			ecsact_event,
+			ecsact_entity_id,
+			ecsact_component_id,
+			const void*,
+			void* user_data
+		) { static_cast<round_trip_state*>(user_data)->update_events += 1; };
+	evc.update_callback_user_data = &rt;
+
+	auto async_evc = ecsact_async_events_collector{};
+	async_evc.async_request_done_callback = //
+		[](
+			ecsact_async_session_id,
+			int                      request_ids_length,
+			ecsact_async_request_id* request_ids,
+			void*                    user_data
+		) {
+			auto rt = static_cast<round_trip_state*>(user_data);
+			for(auto i = 0; request_ids_length > i; ++i) {
+				if(request_ids[i] == rt->last_request_id) {
+					rt->last_done = true;
+				}
+			}
+		};
+	async_evc.async_request_done_callback_user_data = &rt;
+
+	for(auto _ : state) {
+		rt.last_done = false;
+		for(auto i = 0; requests_count > i; ++i) {
+			auto options = ecsact_execution_options{};
+			options.update_components_length = 1;
+			options.update_components_entities = &entities[i];
+			options.update_components = &components[i];
+			rt.last_request_id =
+				ecsact_async_enqueue_execution_options(session_id, options);
+		}
+
+		while(!rt.last_done) {
+			ecsact_async_flush_events(session_id, &evc, &async_evc);
+		}
+	}
+
+	state.counters["update_events"] = benchmark::Counter(
+		static_cast<double>(rt.update_events),
+		benchmark::Counter::kAvgIterations
+	);
+	state.SetItemsProcessed(state.iterations() * requests_count);
+
+	ecsact_async_stop(session_id);
+	ecsact_async_flush_events(session_id, nullptr, nullptr);
+}
+
+BENCHMARK(BM_RoundTrip)
+	->ArgsProduct({
+		{1, 64, 1024},
+		{ECSACT_ASYNC_COALESCE_DEFAULT, ECSACT_ASYNC_COALESCE_TICK},
+	})
+	->UseRealTime();
+
+} // namespace
@@ -0,0 +1,363 @@
+#include <vector>
+#include "gtest/gtest.h"
+#include "async_local/event_buffer.hh"
+#include "async_local/execution_options_coalescer.hh"
+
+using ecsact::async_local::event_buffer;
+using ecsact::async_local::execution_options_coalescer;
+
+namespace {
+
+struct position {
+	int32_t value;
+};
+
+constexpr auto position_id = static_cast<ecsact_component_id>(1);
+constexpr auto entity_a = static_cast<ecsact_entity_id>(10);
+constexpr auto entity_b = static_cast<ecsact_entity_id>(11);
+
+auto composite_sizes() -> std::unordered_map<int32_t, size_t> {
+	return {{static_cast<int32_t>(position_id), sizeof(position)}};
+}
+
+enum class change_kind {
+	add,
+	update,
+	remove,
+	destroy,
+};
+
+/**
+ * Execution options with a single change pointing into itself
+ */
+struct single_change {
+	ecsact_entity_id         entity;
+	position                 data;
+	ecsact_component         component;
+	ecsact_component_id      component_id = position_id;
+	ecsact_execution_options options{};
+
+	single_change(change_kind kind, ecsact_entity_id entity, int32_t value)
+		: entity(entity), data{value}, component{position_id, &data} {
+		switch(kind) {
+			case change_kind::add:
+				options.add_components_length = 1;
+				options.add_components_entities = &this->entity;
+				options.add_components = &component;
+				break;
+			case change_kind::update:
+				options.update_components_length = 1;
+				options.update_components_entities = &this->entity;
+				options.update_components = &component;
+				break;
+			case change_kind::remove:
+				options.remove_components_length = 1;
+				options.remove_components_entities = &this->entity;
+				options.remove_components = &component_id;
+				break;
+			case change_kind::destroy:
+				options.destroy_entities_length = 1;
+				options.destroy_entities = &this->entity;
+				break;
+		}
+	}
+
+	single_change(const single_change&) = delete;
+};
+
+auto add_change(
+	execution_options_coalescer& coalescer,
+	int32_t                      request_id,
+	change_kind                  kind,
+	ecsact_entity_id             entity,
+	int32_t                      value = 0
+) -> bool {
+	auto change = single_change{kind, entity, value};
+	return coalescer.add(
+		static_cast<ecsact_async_request_id>(request_id),
+		change.options
+	);
+}
+
+struct recorded_event {
+	ecsact_event     event;
+	ecsact_entity_id entity;
+	int32_t          value;
+};
+
+auto flush_events(event_buffer& events) -> std::vector<recorded_event> {
+	auto recorded = std::vector<recorded_event>{};
+	auto on_component = //
+		[](
+			ecsact_event        event,
+			ecsact_entity_id    entity,
+			ecsact_component_id,
+			const void* component_data,
+			void*       user_data
+		) {
+			static_cast<std::vector<recorded_event>*>(user_data)->push_back({
+				.event = event,
+				.entity = entity,
+				.value = static_cast<const position*>(component_data)->value,
+			});
+		};
+	auto on_entity = //
+		[](
+			ecsact_event     event,
+			ecsact_entity_id entity,
+			ecsact_placeholder_entity_id,
+			void* user_data
+		) {
+			static_cast<std::vector<recorded_event>*>(user_data)->push_back({
+				.event = event,
+				.entity = entity,
+				.value = 0,
+			});
+		};
+
+	auto evc = ecsact_execution_events_collector{};
+	evc.init_callback = on_component;
+	evc.init_callback_user_data = &recorded;
+	evc.update_callback = on_component;
+	evc.update_callback_user_data = &recorded;
+	evc.remove_callback = on_component;
+	evc.remove_callback_user_data = &recorded;
+	evc.entity_destroyed_callback = on_entity;
+	evc.entity_destroyed_callback_user_data = &recorded;
+	events.flush(&evc);
+	return recorded;
+}
+
+auto record_component(
+	event_buffer&    events,
+	ecsact_event     event,
+	ecsact_entity_id entity,
+	int32_t          value
+) -> void {
+	auto evc = events.collector();
+	auto data = position{value};
+	evc.update_callback(event, entity, position_id, &data, &events);
+}
+
+auto record_destroy(event_buffer& events, ecsact_entity_id entity) -> void {
+	auto evc = events.collector();
+	evc.entity_destroyed_callback(
+		ECSACT_EVENT_DESTROY_ENTITY,
+		entity,
+		static_cast<ecsact_placeholder_entity_id>(0),
+		&events
+	);
+}
+} // namespace
+
+TEST(ExecutionOptionsCoalescer, KeepsLastUpdate) {
+	auto coalescer = execution_options_coalescer{composite_sizes()};
+	ASSERT_TRUE(add_change(coalescer, 0, change_kind::update, entity_a, 1));
+	ASSERT_TRUE(add_change(coalescer, 1, change_kind::update, entity_b, 2));
+	ASSERT_TRUE(add_change(coalescer, 2, change_kind::update, entity_a, 3));
+
+	auto merged = coalescer.merged();
+	ASSERT_EQ(merged.update_components_length, 2);
+	EXPECT_EQ(merged.update_components_entities[0], entity_a);
+	EXPECT_EQ(
+		static_cast<const position*>(merged.update_components[0].component_data)
+			->value,
+		3
+	);
+	EXPECT_EQ(coalescer.request_ids().size(), 3);
+}
+
+TEST(ExecutionOptionsCoalescer, RefusesRepeatedUpdateWithoutDedupe) {
+	auto coalescer = execution_options_coalescer{composite_sizes()};
+	coalescer.set_dedupe_updates(false);
+	ASSERT_TRUE(add_change(coalescer, 0, change_kind::update, entity_a, 1));
+	EXPECT_FALSE(add_change(coalescer, 1, change_kind::update, entity_a, 2));
+	EXPECT_EQ(coalescer.merged().update_components_length, 1);
+}
+
+TEST(ExecutionOptionsCoalescer, RefusesReorderingAddsAndRemoves) {
+	auto coalescer = execution_options_coalescer{composite_sizes()};
+	ASSERT_TRUE(add_change(coalescer, 0, change_kind::remove, entity_a));
+	EXPECT_FALSE(add_change(coalescer, 1, change_kind::add, entity_a, 1));
+	EXPECT_FALSE(add_change(coalescer, 1, change_kind::update, entity_a, 1));
+	EXPECT_FALSE(add_change(coalescer, 1, change_kind::remove, entity_a));
+	EXPECT_TRUE(add_change(coalescer, 1, change_kind::add, entity_b, 1));
+
+	auto merged = coalescer.merged();
+	EXPECT_EQ(merged.remove_components_length, 1);
+	EXPECT_EQ(merged.add_components_length, 1);
+	EXPECT_EQ(coalescer.request_ids().size(), 2);
+}
+
+TEST(ExecutionOptionsCoalescer, RefusesAddAfterUpdate) {
+	auto coalescer = execution_options_coalescer{composite_sizes()};
+	ASSERT_TRUE(add_change(coalescer, 0, change_kind::update, entity_a, 1));
+	EXPECT_FALSE(add_change(coalescer, 1, change_kind::add, entity_a, 1));
+	EXPECT_FALSE(add_change(coalescer, 1, change_kind::remove, entity_a));
+}
+
+TEST(ExecutionOptionsCoalescer, RefusesChangesAroundDestroy) {
+	auto coalescer = execution_options_coalescer{composite_sizes()};
+	ASSERT_TRUE(add_change(coalescer, 0, change_kind::destroy, entity_a));
+	EXPECT_FALSE(add_change(coalescer, 1, change_kind::update, entity_a, 1));
+	EXPECT_FALSE(add_change(coalescer, 1, change_kind::destroy, entity_a));
+	EXPECT_TRUE(add_change(coalescer, 1, change_kind::update, entity_b, 1));
+	EXPECT_FALSE(add_change(coalescer, 2, change_kind::destroy, entity_b));
+}
+
+TEST(ExecutionOptionsCoalescer, NeverRefusesWhenEmpty) {
+	auto coalescer = execution_options_coalescer{composite_sizes()};
+	ASSERT_TRUE(add_change(coalescer, 0, change_kind::add, entity_a, 1));
+	ASSERT_FALSE(add_change(coalescer, 1, change_kind::add, entity_a, 2));
+	coalescer.clear();
+	EXPECT_TRUE(coalescer.empty());
+	EXPECT_TRUE(add_change(coalescer, 1, change_kind::add, entity_a, 2));
+}
+
+TEST(EventBuffer, KeepsEveryUpdateWithoutCoalescing) {
+	auto events = event_buffer{composite_sizes()};
+	record_component(events, ECSACT_EVENT_UPDATE_COMPONENT, entity_a, 1);
+	events.end_tick();
+	record_component(events, ECSACT_EVENT_UPDATE_COMPONENT, entity_a, 2);
+	events.end_tick();
+
+	auto recorded = flush_events(events);
+	ASSERT_EQ(recorded.size(), 2);
+	EXPECT_EQ(recorded[0].value, 1);
+	EXPECT_EQ(recorded[1].value, 2);
+}
+
+TEST(EventBuffer, CoalescesUpdatesAcrossTicks) {
+	auto events = event_buffer{composite_sizes(), true};
+	record_component(events, ECSACT_EVENT_UPDATE_COMPONENT, entity_a, 1);
+	record_component(events, ECSACT_EVENT_UPDATE_COMPONENT, entity_b, 2);
+	events.end_tick();
+	record_component(events, ECSACT_EVENT_UPDATE_COMPONENT, entity_a, 3);
+	events.end_tick();
+
+	// Merged update stays where the first update was with the latest data
+	auto recorded = flush_events(events);
+	ASSERT_EQ(recorded.size(), 2);
+	EXPECT_EQ(recorded[0].entity, entity_a);
+	EXPECT_EQ(recorded[0].value, 3);
+	EXPECT_EQ(recorded[1].entity, entity_b);
+	EXPECT_EQ(recorded[1].value, 2);
+
+	// Nothing is merged into updates that were already flushed
+	record_component(events, ECSACT_EVENT_UPDATE_COMPONENT, entity_a, 4);
+	events.end_tick();
+	recorded = flush_events(events);
+	ASSERT_EQ(recorded.size(), 1);
+	EXPECT_EQ(recorded[0].value, 4);
+}
+
+TEST(EventBuffer, DoesNotCoalesceAcrossRemove) {
+	auto events = event_buffer{composite_sizes(), true};
+	record_component(events, ECSACT_EVENT_UPDATE_COMPONENT, entity_a, 1);
+	events.end_tick();
+	record_component(events, ECSACT_EVENT_REMOVE_COMPONENT, entity_a, 1);
+	record_component(events, ECSACT_EVENT_INIT_COMPONENT, entity_a, 2);
+	events.end_tick();
+	record_component(events, ECSACT_EVENT_UPDATE_COMPONENT, entity_a, 3);
+	events.end_tick();
+
+	auto recorded = flush_events(events);
+	ASSERT_EQ(recorded.size(), 4);
+	EXPECT_EQ(recorded[0].event, ECSACT_EVENT_UPDATE_COMPONENT);
+	EXPECT_EQ(recorded[0].value, 1);
+	EXPECT_EQ(recorded[1].event, ECSACT_EVENT_REMOVE_COMPONENT);
+	EXPECT_EQ(recorded[2].event, ECSACT_EVENT_INIT_COMPONENT);
+	EXPECT_EQ(recorded[3].event, ECSACT_EVENT_UPDATE_COMPONENT);
+	EXPECT_EQ(recorded[3].value, 3);
+}
+
+TEST(EventBuffer, DoesNotCoalesceAcrossDestroy) {
+	auto events = event_buffer{composite_sizes(), true};
+	record_component(events, ECSACT_EVENT_UPDATE_COMPONENT, entity_a, 1);
+	events.end_tick();
+	record_destroy(events, entity_a);
+	events.end_tick();
+	record_component(events, ECSACT_EVENT_UPDATE_COMPONENT, entity_a, 2);
+	events.end_tick();
+
+	auto recorded = flush_events(events);
+	ASSERT_EQ(recorded.size(), 3);
+	EXPECT_EQ(recorded[0].value, 1);
+	EXPECT_EQ(recorded[1].event, ECSACT_EVENT_DESTROY_ENTITY);
+	EXPECT_EQ(recorded[2].value, 2);
+}
+
+TEST(EventBuffer, DestroyOnlyStopsCoalescingThatEntity) {
+	auto events = event_buffer{composite_sizes(), true};
+	record_component(events, ECSACT_EVENT_UPDATE_COMPONENT, entity_a, 1);
+	record_component(events, ECSACT_EVENT_UPDATE_COMPONENT, entity_b, 2);
+	events.end_tick();
+	record_destroy(events, entity_a);
+	events.end_tick();
+	record_component(events, ECSACT_EVENT_UPDATE_COMPONENT, entity_b, 3);
+	events.end_tick();
+
+	auto recorded = flush_events(events);
+	ASSERT_EQ(recorded.size(), 3);
+	EXPECT_EQ(recorded[1].entity, entity_b);
+	EXPECT_EQ(recorded[1].value, 3);
+	EXPECT_EQ(recorded[2].event, ECSACT_EVENT_DESTROY_ENTITY);
+}
+
+TEST(EventBuffer, CoalescesManyComponents) {
+	auto events = event_buffer{composite_sizes(), true};
+	for(auto tick = 0; 2 > tick; ++tick) {
+		for(auto i = 0; 5000 > i; ++i) {
+			auto entity = static_cast<ecsact_entity_id>(i);
+			record_component(events, ECSACT_EVENT_UPDATE_COMPONENT, entity, tick);
+		}
+		events.end_tick();
+	}
+
+	auto recorded = flush_events(events);
+	ASSERT_EQ(recorded.size(), 5000);
+	EXPECT_EQ(recorded[0].value, 1);
+	EXPECT_EQ(recorded[4999].value, 1);
+}
+
+TEST(EventBuffer, CoalescesAfterFlushingBurst) {
+	auto events = event_buffer{composite_sizes(), true};
+	for(auto i = 0; 5000 > i; ++i) {
+		auto entity = static_cast<ecsact_entity_id>(i);
+		record_component(events, ECSACT_EVENT_UPDATE_COMPONENT, entity, 0);
+	}
+	events.end_tick();
+	ASSERT_EQ(flush_events(events).size(), 5000);
+
+	// Entries from before a flush never merge with later events
+	for(auto round = 0; 2 > round; ++round) {
+		for(auto tick = 0; 2 > tick; ++tick) {
+			auto value = round * 10 + tick;
+			record_component(events, ECSACT_EVENT_UPDATE_COMPONENT, entity_a, value);
+			record_component(events, ECSACT_EVENT_UPDATE_COMPONENT, entity_b, value);
+			events.end_tick();
+		}
+
+		auto recorded = flush_events(events);
+		ASSERT_EQ(recorded.size(), 2);
+		EXPECT_EQ(recorded[0].entity, entity_a);
+		EXPECT_EQ(recorded[0].value, round * 10 + 1);
+		EXPECT_EQ(recorded[1].entity, entity_b);
+		EXPECT_EQ(recorded[1].value, round * 10 + 1);
+	}
+}
+
+TEST(EventBuffer, DropsEventsForUnknownComponents) {
+	auto events = event_buffer{composite_sizes()};
+	auto evc = events.collector();
+	auto data = position{1};
+	evc.update_callback(
+		ECSACT_EVENT_UPDATE_COMPONENT,
+		entity_a,
+		static_cast<ecsact_component_id>(99),
+		&data,
+		&events
+	);
+	events.end_tick();
+	EXPECT_TRUE(flush_events(events).empty());
+}
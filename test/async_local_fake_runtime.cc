@@ -0,0 +1,299 @@
+#include "async_local_fake_runtime.hh"
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include "ecsact/runtime/core.h"
+#include "ecsact/runtime/meta.h"
+
+namespace {
+std::atomic<int64_t> execute_count = 0;
+std::atomic<int64_t> stream_count = 0;
+
+/**
+ * @ref ecsact::test::fake_position values by entity. Ordered so the hash does
+ * not depend on insertion order.
+ */
+using fake_registry = std::map<ecsact_entity_id, int32_t>;
+
+std::mutex                                             registries_mutex;
+std::unordered_map<ecsact_registry_id, fake_registry> registries;
+int32_t                                                last_registry_id = 0;
+
+constexpr auto fake_package_id = static_cast<ecsact_package_id>(1);
+constexpr auto fake_field_id = static_cast<ecsact_field_id>(0);
+
+template<typename ID>
+auto write_ids(
+	const ID* ids,
+	int32_t   ids_count,
+	int32_t   max_count,
+	ID*       out_ids,
+	int32_t*  out_count
+) -> void {
+	if(out_ids != nullptr) {
+		for(auto i = 0; ids_count > i && max_count > i; ++i) {
+			out_ids[i] = ids[i];
+		}
+	}
+	if(out_count != nullptr) {
+		*out_count = ids_count;
+	}
+}
+
+auto invoke_component_event(
+	ecsact_event                    event,
+	ecsact_entity_id                entity,
+	ecsact_component_id             component_id,
+	const void*                     component_data,
+	ecsact_component_event_callback callback,
+	void*                           callback_user_data
+) -> void {
+	if(callback != nullptr) {
+		callback(event, entity, component_id, component_data, callback_user_data);
+	}
+}
+
+auto position_value(const ecsact_component& component) -> int32_t {
+	auto position =
+		static_cast<const ecsact::test::fake_position*>(component.component_data);
+	return position->value;
+}
+
+auto apply_positions(
+	ecsact_registry_id              reg_id,
+	const ecsact_execution_options& options
+) -> void {
+	auto  lk = std::scoped_lock{registries_mutex};
+	auto& reg = registries[reg_id];
+	for(auto i = 0; options.add_components_length > i; ++i) {
+		reg[options.add_components_entities[i]] =
+			position_value(options.add_components[i]);
+	}
+	for(auto i = 0; options.update_components_length > i; ++i) {
+		reg[options.update_components_entities[i]] =
+			position_value(options.update_components[i]);
+	}
+	for(auto i = 0; options.remove_components_length > i; ++i) {
+		reg.erase(options.remove_components_entities[i]);
+	}
+	for(auto i = 0; options.destroy_entities_length > i; ++i) {
+		reg.erase(options.destroy_entities[i]);
+	}
+}
+} // namespace
+
+auto ecsact::test::fake_execute_count() -> int64_t {
+	return execute_count.load();
+}
+
+auto ecsact::test::fake_stream_count() -> int64_t {
+	return stream_count.load();
+}
+
+ecsact_registry_id ecsact_create_registry(const char*) {
+	auto lk = std::scoped_lock{registries_mutex};
+	auto reg_id = static_cast<ecsact_registry_id>(++last_registry_id);
+	registries[reg_id] = {};
+	return reg_id;
+}
+
+ecsact_registry_id ecsact_create_registry_ex(
+	const char* registry_name,
+	const ecsact_registry_options*
+) {
+	return ecsact_create_registry(registry_name);
+}
+
+void ecsact_destroy_registry(ecsact_registry_id reg_id) {
+	auto lk = std::scoped_lock{registries_mutex};
+	registries.erase(reg_id);
+}
+
+uint64_t ecsact_hash_registry(ecsact_registry_id reg_id) {
+	auto lk = std::scoped_lock{registries_mutex};
+	auto hash = uint64_t{14695981039346656037ull};
+	auto hash_value = [&](int32_t value) {
+		for(auto i = 0; 4 > i; ++i) {
+			hash ^= static_cast<uint8_t>(static_cast<uint32_t>(value) >> (i * 8));
+			hash *= 1099511628211ull;
+		}
+	};
+	for(auto&& [entity, value] : registries[reg_id]) {
+		hash_value(static_cast<int32_t>(entity));
+		hash_value(value);
+	}
+	return hash;
+}
+
+ecsact_execute_systems_error ecsact_execute_systems(
+	ecsact_registry_id                       reg_id,
+	int                                      execution_count,
+	const ecsact_execution_options*          execution_options_list,
+	const ecsact_execution_events_collector* evc
+) {
+	execute_count.fetch_add(1);
+	if(execution_options_list == nullptr) {
+		return ECSACT_EXEC_SYS_OK;
+	}
+
+	for(auto n = 0; execution_count > n; ++n) {
+		const auto& options = execution_options_list[n];
+		if(options.actions_length > 0) {
+			return ECSACT_EXEC_SYS_ERR_ACTION_ENTITY_INVALID;
+		}
+
+		apply_positions(reg_id, options);
+		if(evc == nullptr) {
+			continue;
+		}
+
+		for(auto i = 0; options.add_components_length > i; ++i) {
+			invoke_component_event(
+				ECSACT_EVENT_INIT_COMPONENT,
+				options.add_components_entities[i],
+				options.add_components[i].component_id,
+				options.add_components[i].component_data,
+				evc->init_callback,
+				evc->init_callback_user_data
+			);
+		}
+		for(auto i = 0; options.update_components_length > i; ++i) {
+			invoke_component_event(
+				ECSACT_EVENT_UPDATE_COMPONENT,
+				options.update_components_entities[i],
+				options.update_components[i].component_id,
+				options.update_components[i].component_data,
+				evc->update_callback,
+				evc->update_callback_user_data
+			);
+		}
+		for(auto i = 0; options.remove_components_length > i; ++i) {
+			auto removed = ecsact::test::fake_position{};
+			invoke_component_event(
+				ECSACT_EVENT_REMOVE_COMPONENT,
+				options.remove_components_entities[i],
+				options.remove_components[i],
+				&removed,
+				evc->remove_callback,
+				evc->remove_callback_user_data
+			);
+		}
+	}
+
+	return ECSACT_EXEC_SYS_OK;
+}
+
+ecsact_stream_error ecsact_stream(
+	ecsact_registry_id,
+	ecsact_entity_id,
+	ecsact_component_id,
+	const void*,
+	const void*
+) {
+	stream_count.fetch_add(1);
+	return ECSACT_STREAM_OK;
+}
+
+int32_t ecsact_meta_count_packages() {
+	return 1;
+}
+
+void ecsact_meta_get_package_ids(
+	int32_t            max_package_count,
+	ecsact_package_id* out_package_ids,
+	int32_t*           out_package_count
+) {
+	write_ids(
+		&fake_package_id,
+		1,
+		max_package_count,
+		out_package_ids,
+		out_package_count
+	);
+}
+
+int32_t ecsact_meta_count_components(ecsact_package_id) {
+	return 1;
+}
+
+void ecsact_meta_get_component_ids(
+	ecsact_package_id,
+	int32_t              max_component_count,
+	ecsact_component_id* out_component_ids,
+	int32_t*             out_component_count
+) {
+	write_ids(
+		&ecsact::test::fake_position_id,
+		1,
+		max_component_count,
+		out_component_ids,
+		out_component_count
+	);
+}
+
+int32_t ecsact_meta_count_transients(ecsact_package_id) {
+	return 0;
+}
+
+void ecsact_meta_get_transient_ids(
+	ecsact_package_id,
+	int32_t,
+	ecsact_transient_id*,
+	int32_t* out_transient_count
+) {
+	if(out_transient_count != nullptr) {
+		*out_transient_count = 0;
+	}
+}
+
+int32_t ecsact_meta_count_actions(ecsact_package_id) {
+	return 0;
+}
+
+void ecsact_meta_get_action_ids(
+	ecsact_package_id,
+	int32_t,
+	ecsact_action_id*,
+	int32_t* out_action_count
+) {
+	if(out_action_count != nullptr) {
+		*out_action_count = 0;
+	}
+}
+
+int32_t ecsact_meta_count_fields(ecsact_composite_id) {
+	return 1;
+}
+
+void ecsact_meta_get_field_ids(
+	ecsact_composite_id,
+	int32_t          max_field_count,
+	ecsact_field_id* out_field_ids,
+	int32_t*         out_field_ids_count
+) {
+	write_ids(
+		&fake_field_id,
+		1,
+		max_field_count,
+		out_field_ids,
+		out_field_ids_count
+	);
+}
+
+ecsact_field_type ecsact_meta_field_type(ecsact_composite_id, ecsact_field_id) {
+	auto type = ecsact_field_type{};
+	type.kind = ECSACT_TYPE_KIND_BUILTIN;
+	type.type.builtin = ECSACT_I32;
+	type.length = 1;
+	return type;
+}
+
+int32_t ecsact_meta_field_offset(ecsact_composite_id, ecsact_field_id) {
+	return 0;
+}
+
+ecsact_builtin_type ecsact_meta_enum_storage_type(ecsact_enum_id) {
+	return ECSACT_I32;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include "ecsact/runtime/common.h"
+
+/**
+ * Minimal core and meta module implementations so the local async module can
+ * be tested and benchmarked without a generated runtime.
+ *
+ * The only package has a single component, @ref fake_position_id, made of one
+ * i32 field. `ecsact_execute_systems` runs no systems. It stores the position
+ * of every add and update per registry, forgets it on remove and destroy, and
+ * invokes the init, update and remove callbacks for them.
+ * `ecsact_hash_registry` hashes the stored positions. The package has no
+ * actions so executing any fails with
+ * `ECSACT_EXEC_SYS_ERR_ACTION_ENTITY_INVALID`.
+ */
+namespace ecsact::test {
+
+struct fake_position {
+	int32_t value;
+};
+
+constexpr auto fake_position_id = static_cast<ecsact_component_id>(1);
+
+/**
+ * Component ID missing from the fake meta module
+ */
+constexpr auto fake_unknown_id = static_cast<ecsact_component_id>(99);
+
+/**
+ * Amount of `ecsact_execute_systems` calls. Safe to call from any thread.
+ */
+auto fake_execute_count() -> int64_t;
+
+/**
+ * Amount of `ecsact_stream` calls. Safe to call from any thread.
+ */
+auto fake_stream_count() -> int64_t;
+
+} // namespace ecsact::test
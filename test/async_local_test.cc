@@ -0,0 +1,402 @@
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <set>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "ecsact/runtime/async.h"
+#include "async_local_fake_runtime.hh"
+
+using namespace std::chrono_literals;
+using ecsact::test::fake_position;
+using ecsact::test::fake_position_id;
+using ecsact::test::fake_unknown_id;
+
+namespace {
+
+/**
+ * Recorded for errors reported without a request ID, such as stream errors
+ */
+constexpr auto no_request_id = static_cast<ecsact_async_request_id>(-1);
+
+struct request_error {
+	ecsact_async_error      error;
+	ecsact_async_request_id request_id;
+};
+
+/**
+ * Everything delivered by `ecsact_async_flush_events`
+ */
+struct flushed_events {
+	std::vector<ecsact_async_request_id>    done;
+	std::vector<request_error>              errors;
+	std::vector<ecsact_async_session_event> session_events;
+	std::vector<int32_t>                    updated_values;
+
+	auto has_session_event(ecsact_async_session_event event) const -> bool {
+		return std::find(session_events.begin(), session_events.end(), event) !=
+			session_events.end();
+	}
+
+	auto has_error(ecsact_async_error error, ecsact_async_request_id id) const
+		-> bool {
+		return std::any_of(errors.begin(), errors.end(), [&](auto& err) {
+			return err.error == error && err.request_id == id;
+		});
+	}
+
+	auto is_done(ecsact_async_request_id id) const -> bool {
+		return std::find(done.begin(), done.end(), id) != done.end();
+	}
+};
+
+auto flush(ecsact_async_session_id session_id, flushed_events& out) -> void {
+	auto evc = ecsact_execution_events_collector{};
+	evc.update_callback = //
+		[](
+			ecsact_event,
+			ecsact_entity_id,
+			ecsact_component_id,
+			const void* component_data,
+			void*       user_data
+		) {
+			static_cast<flushed_events*>(user_data)->updated_values.push_back(
+				static_cast<const fake_position*>(component_data)->value
+			);
+		};
+	evc.update_callback_user_data = &out;
+
+	auto async_evc = ecsact_async_events_collector{};
+	async_evc.async_error_callback = //
+		[](
+			ecsact_async_session_id,
+			ecsact_async_error       error,
+			int                      request_ids_length,
+			ecsact_async_request_id* request_ids,
+			void*                    user_data
+		) {
+			auto& errors = static_cast<flushed_events*>(user_data)->errors;
+			for(auto i = 0; request_ids_length > i; ++i) {
+				errors.push_back({error, request_ids[i]});
+			}
+			if(request_ids_length == 0) {
+				errors.push_back({error, no_request_id});
+			}
+		};
+	async_evc.async_error_callback_user_data = &out;
+	async_evc.async_request_done_callback = //
+		[](
+			ecsact_async_session_id,
+			int                      request_ids_length,
+			ecsact_async_request_id* request_ids,
+			void*                    user_data
+		) {
+			auto& done = static_cast<flushed_events*>(user_data)->done;
+			done.insert(done.end(), request_ids, request_ids + request_ids_length);
+		};
+	async_evc.async_request_done_callback_user_data = &out;
+	async_evc.async_session_event_callback = //
+		[](
+			ecsact_async_session_id,
+			ecsact_async_session_event event,
+			void*                      user_data
+		) {
+			static_cast<flushed_events*>(user_data)->session_events.push_back(event);
+		};
+	async_evc.async_session_event_callback_user_data = &out;
+
+	ecsact_async_flush_events(session_id, &evc, &async_evc);
+}
+
+/**
+ * Flush until @p done returns `true` or a few seconds pass
+ */
+auto flush_until(
+	ecsact_async_session_id                     session_id,
+	flushed_events&                             out,
+	std::function<bool(const flushed_events&)> done
+) -> bool {
+	auto deadline = std::chrono::steady_clock::now() + 5s;
+	while(std::chrono::steady_clock::now() < deadline) {
+		flush(session_id, out);
+		if(done(out)) {
+			return true;
+		}
+		std::this_thread::sleep_for(1ms);
+	}
+	return false;
+}
+
+auto start_session(
+	int32_t tick_rate_hz,
+	int32_t queue_high_water_mark = 0
+) -> ecsact_async_session_id {
+	auto options = ecsact_async_tick_options{};
+	options.magic = ECSACT_ASYNC_TICK_OPTIONS_MAGIC;
+	options.struct_size = sizeof(options);
+	options.tick_rate_hz = tick_rate_hz;
+	options.queue_high_water_mark = queue_high_water_mark;
+	return ecsact_async_start(&options, sizeof(options));
+}
+
+/**
+ * Execution options updating a single @ref fake_position
+ */
+struct update_options {
+	ecsact_entity_id         entity = static_cast<ecsact_entity_id>(0);
+	fake_position            data;
+	ecsact_component         component;
+	ecsact_execution_options options{};
+
+	update_options(int32_t value, ecsact_component_id id = fake_position_id)
+		: data{value}, component{id, &data} {
+		options.update_components_length = 1;
+		options.update_components_entities = &entity;
+		options.update_components = &component;
+	}
+
+	update_options(const update_options&) = delete;
+};
+
+class AsyncLocal : public testing::Test {
+protected:
+	void TearDown() override {
+		ecsact_async_force_reset();
+	}
+};
+} // namespace
+
+TEST_F(AsyncLocal, EnqueueExecutesAndReportsDone) {
+	auto session_id = start_session(1000);
+	auto update = update_options{42};
+	auto request_id =
+		ecsact_async_enqueue_execution_options(session_id, update.options);
+
+	auto events = flushed_events{};
+	ASSERT_TRUE(flush_until(session_id, events, [&](auto& events) {
+		return events.is_done(request_id);
+	}));
+	EXPECT_TRUE(events.has_session_event(ECSACT_ASYNC_SESSION_START));
+	EXPECT_TRUE(events.errors.empty());
+
+	// Events are recorded before their request is reported done so they are
+	// delivered by the next flush at the latest
+	flush(session_id, events);
+	ASSERT_EQ(events.updated_values.size(), 1);
+	EXPECT_EQ(events.updated_values[0], 42);
+}
+
+TEST_F(AsyncLocal, RejectsAtHighWaterMark) {
+	// Slow enough that nothing is consumed while enqueuing
+	auto session_id = start_session(1, 2);
+	auto update = update_options{1};
+	auto first =
+		ecsact_async_enqueue_execution_options(session_id, update.options);
+	auto second =
+		ecsact_async_enqueue_execution_options(session_id, update.options);
+	auto rejected =
+		ecsact_async_enqueue_execution_options(session_id, update.options);
+
+	auto events = flushed_events{};
+	flush(session_id, events);
+	EXPECT_TRUE(events.has_error(ECSACT_ASYNC_ERR_BACK_PRESSURE, rejected));
+	EXPECT_FALSE(events.has_error(ECSACT_ASYNC_ERR_BACK_PRESSURE, first));
+	EXPECT_FALSE(events.has_error(ECSACT_ASYNC_ERR_BACK_PRESSURE, second));
+}
+
+TEST_F(AsyncLocal, StopInterruptsTickWait) {
+	auto pacings = {
+		ECSACT_ASYNC_PACING_SLEEP,
+		ECSACT_ASYNC_PACING_SPIN,
+		ECSACT_ASYNC_PACING_HYBRID,
+	};
+	for(auto pacing : pacings) {
+		auto options = ecsact_async_tick_options{};
+		options.magic = ECSACT_ASYNC_TICK_OPTIONS_MAGIC;
+		options.struct_size = sizeof(options);
+		options.tick_rate_hz = 1;
+		options.pacing = pacing;
+		auto session_id = ecsact_async_start(&options, sizeof(options));
+
+		auto start = std::chrono::steady_clock::now();
+		ecsact_async_stop(session_id);
+		EXPECT_LT(std::chrono::steady_clock::now() - start, 500ms) << pacing;
+		ecsact_async_force_reset();
+	}
+}
+
+TEST_F(AsyncLocal, RejectsOptionsItCannotCopy) {
+	auto session_id = start_session(1000);
+	auto unknown = update_options{1, fake_unknown_id};
+	auto unknown_id =
+		ecsact_async_enqueue_execution_options(session_id, unknown.options);
+
+	auto indexed = update_options{1};
+	const void* indexed_field_values[] = {nullptr};
+	indexed.options.update_components_indexed_fields = indexed_field_values;
+	auto indexed_id =
+		ecsact_async_enqueue_execution_options(session_id, indexed.options);
+
+	auto events = flushed_events{};
+	flush(session_id, events);
+	EXPECT_TRUE(events.has_error(ECSACT_ASYNC_ERR_UNSUPPORTED, unknown_id));
+	EXPECT_TRUE(events.has_error(ECSACT_ASYNC_ERR_UNSUPPORTED, indexed_id));
+}
+
+TEST_F(AsyncLocal, CarriesRefusedRequestsToTheNextTick) {
+	auto executions_before = ecsact::test::fake_execute_count();
+
+	// The default policy keeps every update so updates to the same component
+	// never merge into one tick
+	auto session_id = start_session(100);
+	auto first = update_options{1};
+	auto second = update_options{2};
+	auto third = update_options{3};
+	auto request_ids = std::vector{
+		ecsact_async_enqueue_execution_options(session_id, first.options),
+		ecsact_async_enqueue_execution_options(session_id, second.options),
+		ecsact_async_enqueue_execution_options(session_id, third.options),
+	};
+
+	auto events = flushed_events{};
+	ASSERT_TRUE(flush_until(session_id, events, [&](auto& events) {
+		return events.is_done(request_ids.back());
+	}));
+	ecsact_async_stop(session_id);
+
+	// Stopping joins the tick thread so every tick has finished. Read before
+	// flushing the stop event erases the session.
+	auto ticks = ecsact_async_get_current_tick(session_id);
+	flush(session_id, events);
+	EXPECT_EQ(ecsact::test::fake_execute_count() - executions_before, ticks);
+	EXPECT_EQ(events.done, request_ids);
+	EXPECT_EQ(events.updated_values, (std::vector<int32_t>{1, 2, 3}));
+	EXPECT_TRUE(events.errors.empty());
+}
+
+TEST_F(AsyncLocal, RejectsUnknownCoalescePolicies) {
+	auto session_id = start_session(1000);
+	EXPECT_EQ(
+		ecsact_async_set_coalesce_policy(session_id, ECSACT_ASYNC_COALESCE_TICK),
+		ECSACT_ASYNC_OK
+	);
+	EXPECT_EQ(
+		ecsact_async_set_coalesce_policy(
+			session_id,
+			static_cast<ecsact_async_coalesce_policy>(2)
+		),
+		ECSACT_ASYNC_ERR_UNSUPPORTED
+	);
+	EXPECT_EQ(
+		ecsact_async_set_coalesce_policy(
+			session_id,
+			static_cast<ecsact_async_coalesce_policy>(-1)
+		),
+		ECSACT_ASYNC_ERR_UNSUPPORTED
+	);
+}
+
+TEST_F(AsyncLocal, RejectsStreamsWithIndexedFields) {
+	auto streams_before = ecsact::test::fake_stream_count();
+	auto session_id = start_session(1000);
+	auto data = fake_position{1};
+	const void* indexed_field_values[] = {nullptr};
+	ecsact_async_stream(
+		session_id,
+		static_cast<ecsact_entity_id>(0),
+		fake_position_id,
+		&data,
+		indexed_field_values
+	);
+
+	auto events = flushed_events{};
+	flush(session_id, events);
+	EXPECT_TRUE(events.has_error(ECSACT_ASYNC_ERR_UNSUPPORTED, no_request_id));
+
+	// Streams are sent in order so once this one is sent the rejected one
+	// would have been too
+	ecsact_async_stream(
+		session_id,
+		static_cast<ecsact_entity_id>(0),
+		fake_position_id,
+		&data,
+		nullptr
+	);
+	ASSERT_TRUE(flush_until(session_id, events, [&](auto&) {
+		return ecsact::test::fake_stream_count() != streams_before;
+	}));
+	ecsact_async_stop(session_id);
+	EXPECT_EQ(ecsact::test::fake_stream_count() - streams_before, 1);
+}
+
+TEST_F(AsyncLocal, StopFlushLifecycle) {
+	auto session_id = start_session(1000);
+	auto events = flushed_events{};
+	flush(session_id, events);
+	ASSERT_TRUE(events.has_session_event(ECSACT_ASYNC_SESSION_START));
+
+	ecsact_async_stop(session_id);
+	auto update = update_options{1};
+	auto after_stop =
+		ecsact_async_enqueue_execution_options(session_id, update.options);
+	EXPECT_EQ(
+		ecsact_async_set_coalesce_policy(session_id, ECSACT_ASYNC_COALESCE_TICK),
+		ECSACT_ASYNC_ERR_NOT_CONNECTED
+	);
+
+	// Stopped sessions stay until their stop event is flushed
+	flush(session_id, events);
+	EXPECT_TRUE(events.has_error(ECSACT_ASYNC_ERR_NOT_CONNECTED, after_stop));
+	ASSERT_TRUE(events.has_session_event(ECSACT_ASYNC_SESSION_STOPPED));
+
+	EXPECT_EQ(
+		ecsact_async_enqueue_execution_options(session_id, update.options),
+		static_cast<ecsact_async_request_id>(-1)
+	);
+	auto after_erase = flushed_events{};
+	flush(session_id, after_erase);
+	EXPECT_TRUE(after_erase.session_events.empty());
+}
+
+TEST_F(AsyncLocal, EveryRequestFinishesWhenStoppedWhileEnqueuing) {
+	auto session_id = start_session(1000);
+	auto update = update_options{1};
+
+	auto producers = std::vector<std::thread>{};
+	auto request_ids = std::vector<std::vector<ecsact_async_request_id>>(4);
+	for(auto& ids : request_ids) {
+		producers.emplace_back([&] {
+			for(auto i = 0; 500 > i; ++i) {
+				ids.push_back(
+					ecsact_async_enqueue_execution_options(session_id, update.options)
+				);
+			}
+		});
+	}
+
+	std::this_thread::sleep_for(1ms);
+	ecsact_async_stop(session_id);
+	for(auto& producer : producers) {
+		producer.join();
+	}
+
+	auto events = flushed_events{};
+	ASSERT_TRUE(flush_until(session_id, events, [](auto& events) {
+		return events.has_session_event(ECSACT_ASYNC_SESSION_STOPPED);
+	}));
+
+	// Each request is reported exactly once, either done or with an error
+	auto finished = std::multiset<int32_t>{};
+	for(auto id : events.done) {
+		finished.insert(static_cast<int32_t>(id));
+	}
+	for(auto& err : events.errors) {
+		finished.insert(static_cast<int32_t>(err.request_id));
+	}
+	for(auto& ids : request_ids) {
+		for(auto id : ids) {
+			EXPECT_EQ(finished.count(static_cast<int32_t>(id)), 1);
+		}
+	}
+}
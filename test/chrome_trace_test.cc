@@ -0,0 +1,445 @@
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "gtest/gtest.h"
+#include "ecsact/runtime/meta.h"
+#include "ecsact/runtime/profile.h"
+#include "profile/chrome_trace.hh"
+
+using namespace std::chrono_literals;
+using ecsact::profile::chrome_trace_writer;
+
+namespace {
+
+constexpr auto registry_id = static_cast<ecsact_registry_id>(3);
+constexpr auto parent_system_id = static_cast<ecsact_system_like_id>(1);
+constexpr auto child_system_id = static_cast<ecsact_system_like_id>(2);
+constexpr auto now_ns = int64_t{5'000'000};
+
+/**
+ * Just enough JSON to check what the writer produced
+ */
+struct json_value {
+	enum class kind {
+		null,
+		boolean,
+		number,
+		string,
+		array,
+		object,
+	};
+
+	kind                     type = kind::null;
+	bool                     boolean = false;
+	double                   number = 0.0;
+	std::string              string;
+	std::vector<json_value>  items;
+	std::vector<std::string> keys;
+
+	auto get(std::string_view key) const -> const json_value* {
+		for(size_t i = 0; keys.size() > i; ++i) {
+			if(keys[i] == key) {
+				return &items[i];
+			}
+		}
+		return nullptr;
+	}
+
+	auto string_or(std::string_view key, std::string fallback) const
+		-> std::string {
+		auto value = get(key);
+		return value && value->type == kind::string ? value->string : fallback;
+	}
+
+	auto number_or(std::string_view key, double fallback) const -> double {
+		auto value = get(key);
+		return value && value->type == kind::number ? value->number : fallback;
+	}
+};
+
+class json_parser {
+public:
+	json_parser(std::string_view input) : _in(input) {
+	}
+
+	/**
+	 * @returns `std::nullopt` if the input is not exactly one JSON value
+	 */
+	auto parse() -> std::optional<json_value> {
+		auto value = parse_value();
+		skip_whitespace();
+		if(!value || _pos != _in.size()) {
+			return std::nullopt;
+		}
+		return value;
+	}
+
+private:
+	std::string_view _in;
+	size_t           _pos = 0;
+
+	auto skip_whitespace() -> void {
+		while(_pos < _in.size() && std::isspace(_in[_pos])) {
+			_pos += 1;
+		}
+	}
+
+	auto consume(char c) -> bool {
+		skip_whitespace();
+		if(_pos < _in.size() && _in[_pos] == c) {
+			_pos += 1;
+			return true;
+		}
+		return false;
+	}
+
+	auto consume_literal(std::string_view literal) -> bool {
+		if(_in.substr(_pos, literal.size()) == literal) {
+			_pos += literal.size();
+			return true;
+		}
+		return false;
+	}
+
+	auto parse_value() -> std::optional<json_value> {
+		skip_whitespace();
+		if(_pos >= _in.size()) {
+			return std::nullopt;
+		}
+
+		auto value = json_value{};
+		switch(_in[_pos]) {
+			case '{':
+				return parse_object();
+			case '[':
+				return parse_array();
+			case '"':
+				value.type = json_value::kind::string;
+				if(!parse_string(value.string)) {
+					return std::nullopt;
+				}
+				return value;
+			case 't':
+			case 'f':
+				value.type = json_value::kind::boolean;
+				value.boolean = _in[_pos] == 't';
+				if(!consume_literal(value.boolean ? "true" : "false")) {
+					return std::nullopt;
+				}
+				return value;
+			case 'n':
+				if(!consume_literal("null")) {
+					return std::nullopt;
+				}
+				return value;
+			default:
+				return parse_number();
+		}
+	}
+
+	auto parse_object() -> std::optional<json_value> {
+		auto value = json_value{};
+		value.type = json_value::kind::object;
+		consume('{');
+		if(consume('}')) {
+			return value;
+		}
+		do {
+			skip_whitespace();
+			auto& key = value.keys.emplace_back();
+			if(!parse_string(key) || !consume(':')) {
+				return std::nullopt;
+			}
+			auto item = parse_value();
+			if(!item) {
+				return std::nullopt;
+			}
+			value.items.push_back(std::move(*item));
+		} while(consume(','));
+		if(!consume('}')) {
+			return std::nullopt;
+		}
+		return value;
+	}
+
+	auto parse_array() -> std::optional<json_value> {
+		auto value = json_value{};
+		value.type = json_value::kind::array;
+		consume('[');
+		if(consume(']')) {
+			return value;
+		}
+		do {
+			auto item = parse_value();
+			if(!item) {
+				return std::nullopt;
+			}
+			value.items.push_back(std::move(*item));
+		} while(consume(','));
+		if(!consume(']')) {
+			return std::nullopt;
+		}
+		return value;
+	}
+
+	auto parse_string(std::string& out) -> bool {
+		if(_pos >= _in.size() || _in[_pos] != '"') {
+			return false;
+		}
+		_pos += 1;
+		while(_pos < _in.size()) {
+			auto c = _in[_pos++];
+			if(c == '"') {
+				return true;
+			}
+			if(static_cast<unsigned char>(c) < 0x20) {
+				return false;
+			}
+			if(c != '\\') {
+				out.push_back(c);
+				continue;
+			}
+			if(_pos >= _in.size()) {
+				return false;
+			}
+			switch(_in[_pos++]) {
+				case '"':
+					out.push_back('"');
+					break;
+				case '\\':
+					out.push_back('\\');
+					break;
+				case 'n':
+					out.push_back('\n');
+					break;
+				case 'u':
+					if(_pos + 4 > _in.size()) {
+						return false;
+					}
+					out.push_back(static_cast<char>(
+						std::strtol(std::string{_in.substr(_pos, 4)}.c_str(), nullptr, 16)
+					));
+					_pos += 4;
+					break;
+				default:
+					return false;
+			}
+		}
+		return false;
+	}
+
+	auto parse_number() -> std::optional<json_value> {
+		auto start = _pos;
+		while(_pos < _in.size() &&
+					(std::isdigit(_in[_pos]) || _in[_pos] == '-' || _in[_pos] == '+' ||
+					 _in[_pos] == '.' || _in[_pos] == 'e' || _in[_pos] == 'E')) {
+			_pos += 1;
+		}
+		if(start == _pos) {
+			return std::nullopt;
+		}
+
+		auto text = std::string{_in.substr(start, _pos - start)};
+		auto end = static_cast<char*>(nullptr);
+		auto value = json_value{};
+		value.type = json_value::kind::number;
+		value.number = std::strtod(text.c_str(), &end);
+		if(end != text.c_str() + text.size()) {
+			return std::nullopt;
+		}
+		return value;
+	}
+};
+
+auto trace_path(const char* name) -> std::string {
+	return testing::TempDir() + name;
+}
+
+/**
+ * @returns the `traceEvents` array of the trace at @p path or `std::nullopt`
+ *          if the file is not valid JSON
+ */
+auto read_trace_events(const std::string& path)
+	-> std::optional<std::vector<json_value>> {
+	auto file = std::ifstream{path};
+	auto contents = std::stringstream{};
+	contents << file.rdbuf();
+
+	auto trace = json_parser{contents.str()}.parse();
+	if(!trace || trace->type != json_value::kind::object) {
+		return std::nullopt;
+	}
+	auto events = trace->get("traceEvents");
+	if(!events || events->type != json_value::kind::array) {
+		return std::nullopt;
+	}
+	return events->items;
+}
+
+auto find_events(const std::vector<json_value>& events, std::string_view ph)
+	-> std::vector<const json_value*> {
+	auto found = std::vector<const json_value*>{};
+	for(auto& ev : events) {
+		if(ev.string_or("ph", "") == ph) {
+			found.push_back(&ev);
+		}
+	}
+	return found;
+}
+
+auto make_sample(int32_t thread_index, int64_t start_ns)
+	-> ecsact_profile_system_sample {
+	auto sample = ecsact_profile_system_sample{};
+	sample.system_like_id = child_system_id;
+	sample.thread_index = thread_index;
+	sample.execution_index = 4;
+	sample.start_ns = start_ns;
+	sample.duration_ns = 2'500;
+	sample.entities_iterated = 6;
+	sample.entities_skipped = 1;
+	return sample;
+}
+} // namespace
+
+// Meta and profile functions the writer looks up names and time with
+
+const char* ecsact_meta_registry_name(ecsact_registry_id) {
+	return "test registry";
+}
+
+const char* ecsact_meta_decl_full_name(ecsact_decl_id id) {
+	if(id == ecsact_id_cast<ecsact_decl_id>(parent_system_id)) {
+		return "test.Parent";
+	}
+	if(id == ecsact_id_cast<ecsact_decl_id>(child_system_id)) {
+		return "test.Parent.\"Child\"";
+	}
+	return nullptr;
+}
+
+ecsact_system_like_id ecsact_meta_get_parent_system_id(ecsact_system_id id) {
+	if(ecsact_id_cast<ecsact_system_like_id>(id) == child_system_id) {
+		return parent_system_id;
+	}
+	return ECSACT_INVALID_ID(system_like);
+}
+
+int64_t ecsact_profile_now() {
+	return now_ns;
+}
+
+TEST(ChromeTraceWriter, WritesSamplesAndMarkers) {
+	auto path = trace_path("chrome_trace_samples.json");
+	{
+		auto writer = chrome_trace_writer{{.output_path = path}};
+		ASSERT_TRUE(writer.is_open());
+
+		auto samples = std::vector{make_sample(0, 1'000), make_sample(1, 1'500)};
+		writer.push_samples(registry_id, samples);
+		writer.mark_tick(7);
+		writer.mark_flush();
+		EXPECT_EQ(writer.dropped_count(), 0);
+	}
+
+	auto events = read_trace_events(path);
+	ASSERT_TRUE(events.has_value());
+
+	auto slices = find_events(*events, "X");
+	ASSERT_EQ(slices.size(), 2);
+	for(auto i = 0; 2 > i; ++i) {
+		auto& slice = *slices[i];
+		EXPECT_EQ(slice.string_or("name", ""), "test.Parent.\"Child\"");
+		EXPECT_EQ(slice.number_or("pid", -1), 3);
+		EXPECT_EQ(slice.number_or("tid", -1), i);
+		EXPECT_DOUBLE_EQ(slice.number_or("ts", 0), i == 0 ? 1.0 : 1.5);
+		EXPECT_DOUBLE_EQ(slice.number_or("dur", 0), 2.5);
+
+		auto args = slice.get("args");
+		ASSERT_NE(args, nullptr);
+		EXPECT_EQ(args->number_or("execution", -1), 4);
+		EXPECT_EQ(args->number_or("entities", -1), 6);
+		EXPECT_EQ(args->number_or("skipped", -1), 1);
+		EXPECT_EQ(args->string_or("parent", ""), "test.Parent");
+	}
+
+	auto markers = find_events(*events, "i");
+	ASSERT_EQ(markers.size(), 2);
+	EXPECT_EQ(markers[0]->string_or("name", ""), "tick 7");
+	EXPECT_EQ(markers[1]->string_or("name", ""), "flush");
+	for(auto marker : markers) {
+		EXPECT_EQ(marker->number_or("pid", 0), -1);
+		EXPECT_DOUBLE_EQ(marker->number_or("ts", 0), 5'000.0);
+	}
+	EXPECT_NE(
+		markers[0]->number_or("tid", -1),
+		markers[1]->number_or("tid", -1)
+	);
+
+	auto process_names = std::vector<std::string>{};
+	for(auto metadata : find_events(*events, "M")) {
+		if(metadata->string_or("name", "") == "process_name") {
+			process_names.push_back(metadata->get("args")->string_or("name", ""));
+		}
+	}
+	ASSERT_EQ(process_names.size(), 2);
+	EXPECT_EQ(process_names[0], "test registry");
+	EXPECT_EQ(process_names[1], "async");
+}
+
+TEST(ChromeTraceWriter, DropsSamplesWhenRingIsFull) {
+	auto path = trace_path("chrome_trace_overflow.json");
+	{
+		// Nothing is written before the writer is destroyed
+		auto writer = chrome_trace_writer{{
+			.output_path = path,
+			.ring_buffer_capacity = 4,
+			.flush_interval = 1h,
+		}};
+		ASSERT_TRUE(writer.is_open());
+
+		auto samples = std::vector<ecsact_profile_system_sample>{};
+		for(auto i = 0; 10 > i; ++i) {
+			samples.push_back(make_sample(0, i * 1'000));
+		}
+		writer.push_samples(registry_id, samples);
+		writer.mark_tick(1);
+		EXPECT_EQ(writer.dropped_count(), 7);
+	}
+
+	// Destroying the writer did not wait for the flush interval and wrote the
+	// samples that fit
+	auto events = read_trace_events(path);
+	ASSERT_TRUE(events.has_value());
+	auto slices = find_events(*events, "X");
+	ASSERT_EQ(slices.size(), 4);
+	for(auto i = 0; 4 > i; ++i) {
+		EXPECT_DOUBLE_EQ(slices[i]->number_or("ts", 0), i);
+	}
+	EXPECT_TRUE(find_events(*events, "i").empty());
+}
+
+TEST(ChromeTraceWriter, WritesValidJsonWithoutEvents) {
+	auto path = trace_path("chrome_trace_empty.json");
+	{
+		auto writer = chrome_trace_writer{{.output_path = path}};
+		ASSERT_TRUE(writer.is_open());
+	}
+
+	auto events = read_trace_events(path);
+	ASSERT_TRUE(events.has_value());
+	EXPECT_TRUE(events->empty());
+}
+
+TEST(ChromeTraceWriter, ReportsUnopenedFile) {
+	auto writer = chrome_trace_writer{{
+		.output_path = trace_path("missing_directory/chrome_trace.json"),
+	}};
+	EXPECT_FALSE(writer.is_open());
+	writer.mark_tick(1);
+}
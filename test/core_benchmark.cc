@@ -0,0 +1,868 @@
+/**
+ * Benchmarks standard ECS workloads through the Ecsact runtime C ABI. The
+ * runtime is loaded at startup so different runtime builds can be compared
+ * with the same benchmark binary.
+ *
+ * Usage:
+ *   core_benchmark --ecsact_runtime=path/to/runtime.so [benchmark flags]
+ *
+ * The runtime path may also be set with the `ECSACT_RUNTIME` environment
+ * variable.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "benchmark/benchmark.h"
+#include "ecsact/runtime.h"
+#include "ecsact/runtime/dylib.h"
+
+#ifdef _WIN32
+#	include <windows.h>
+#else
+#	include <dlfcn.h>
+#endif
+
+namespace {
+
+/**
+ * Every benchmark component has a single i32 field so they can be written
+ * from the benchmark with this struct.
+ */
+struct bench_component {
+	int32_t value;
+};
+
+constexpr auto max_iterate_components = 4;
+
+struct bench_schema {
+	ecsact_package_id package_id;
+
+	/**
+	 * Plain components used by the iterate, churn and serialize workloads
+	 */
+	ecsact_component_id components[max_iterate_components];
+
+	/**
+	 * Tag component per iterate workload so each iterate system only matches
+	 * the entities created for it.
+	 */
+	ecsact_component_id iterate_tags[max_iterate_components];
+	ecsact_system_id    iterate_systems[max_iterate_components];
+
+	ecsact_component_id notify_component;
+	ecsact_system_id    notify_system;
+
+	ecsact_component_id stream_component;
+
+	ecsact_component_id health_component;
+	ecsact_transient_id damage_transient;
+	ecsact_system_id    damage_apply_system;
+	ecsact_system_id    damage_resolve_system;
+};
+
+auto schema = bench_schema{};
+
+std::atomic_int64_t notify_invocations = 0;
+
+#ifdef _WIN32
+using runtime_handle = HMODULE;
+
+auto open_runtime(const std::string& runtime_path) -> runtime_handle {
+	return LoadLibraryA(runtime_path.c_str());
+}
+
+auto runtime_symbol(runtime_handle runtime, const char* fn_name) -> void (*)() {
+	return reinterpret_cast<void (*)()>(GetProcAddress(runtime, fn_name));
+}
+#else
+using runtime_handle = void*;
+
+auto open_runtime(const std::string& runtime_path) -> runtime_handle {
+	return dlopen(runtime_path.c_str(), RTLD_NOW | RTLD_LOCAL);
+}
+
+auto runtime_symbol(runtime_handle runtime, const char* fn_name) -> void (*)() {
+	return reinterpret_cast<void (*)()>(dlsym(runtime, fn_name));
+}
+#endif
+
+auto load_runtime(const std::string& runtime_path) -> bool {
+	auto runtime = open_runtime(runtime_path);
+	if(runtime == nullptr) {
+		std::cerr << "Failed to load runtime " << runtime_path << "\n";
+		return false;
+	}
+
+	auto loaded_count = 0;
+
+#define LOAD_FN(fn_name, unused)                      \
+	if(ecsact_dylib_has_fn(#fn_name)) {                 \
+		auto fn_addr = runtime_symbol(runtime, #fn_name); \
+		if(fn_addr != nullptr) {                          \
+			ecsact_dylib_set_fn_addr(#fn_name, fn_addr);    \
+			loaded_count += 1;                              \
+		}                                                 \
+	}                                                   \
+	static_assert(true, "macro requires ;")
+
+	FOR_EACH_ECSACT_API_FN(LOAD_FN, unused);
+
+#undef LOAD_FN
+
+	std::cerr << "Loaded " << loaded_count << " functions from " << runtime_path
+						<< "\n";
+	return true;
+}
+
+/**
+ * Checks the functions every benchmark and the schema setup use. Functions
+ * only some benchmarks use are checked by those benchmarks with
+ * BENCH_REQUIRE_FN so runtimes that only implement part of the API can still
+ * be compared.
+ */
+auto required_fns_loaded() -> bool {
+	auto ok = true;
+#define CHECK_FN(fn_name)                                         \
+	if((fn_name) == nullptr) {                                      \
+		std::cerr << "Runtime is missing required fn " #fn_name "\n"; \
+		ok = false;                                                   \
+	}                                                               \
+	static_assert(true, "macro requires ;")
+
+	CHECK_FN(ecsact_create_registry);
+	CHECK_FN(ecsact_destroy_registry);
+	CHECK_FN(ecsact_create_entity);
+	CHECK_FN(ecsact_add_component);
+	CHECK_FN(ecsact_execute_systems);
+	CHECK_FN(ecsact_create_package);
+	CHECK_FN(ecsact_create_component);
+	CHECK_FN(ecsact_create_transient);
+	CHECK_FN(ecsact_add_field);
+	CHECK_FN(ecsact_create_system);
+	CHECK_FN(ecsact_set_system_capability);
+	CHECK_FN(ecsact_set_system_execution_impl);
+	CHECK_FN(ecsact_system_execution_context_get);
+	CHECK_FN(ecsact_system_execution_context_update);
+	CHECK_FN(ecsact_system_execution_context_add);
+
+#undef CHECK_FN
+	return ok;
+}
+
+/**
+ * Skips the current benchmark if the runtime does not have @p fn_name
+ */
+#define BENCH_REQUIRE_FN(state, fn_name)                      \
+	if((fn_name) == nullptr) {                                  \
+		(state).SkipWithError("Runtime is missing fn " #fn_name); \
+		return;                                                   \
+	}                                                           \
+	static_assert(true, "macro requires ;")
+
+auto create_component( //
+	std::string_view    name,
+	ecsact_builtin_type field_type = ECSACT_I32
+) -> ecsact_component_id {
+	auto comp_id = ecsact_create_component(
+		schema.package_id,
+		name.data(),
+		static_cast<int32_t>(name.size())
+	);
+
+	auto field_type_info = ecsact_field_type{};
+	field_type_info.kind = ECSACT_TYPE_KIND_BUILTIN;
+	field_type_info.type.builtin = field_type;
+	field_type_info.length = 1;
+	ecsact_add_field(
+		ecsact_id_cast<ecsact_composite_id>(comp_id),
+		field_type_info,
+		"value",
+		5
+	);
+
+	return comp_id;
+}
+
+auto create_system(std::string_view name) -> ecsact_system_id {
+	return ecsact_create_system(
+		schema.package_id,
+		name.data(),
+		static_cast<int32_t>(name.size())
+	);
+}
+
+auto as_sys(ecsact_system_id id) -> ecsact_system_like_id {
+	return ecsact_id_cast<ecsact_system_like_id>(id);
+}
+
+auto as_comp(ecsact_component_id id) -> ecsact_component_like_id {
+	return ecsact_id_cast<ecsact_component_like_id>(id);
+}
+
+template<int ComponentCount>
+void iterate_system_impl(ecsact_system_execution_context* ctx) {
+	for(auto i = 0; ComponentCount > i; ++i) {
+		auto comp = bench_component{};
+		auto comp_id = as_comp(schema.components[i]);
+		ecsact_system_execution_context_get(ctx, comp_id, &comp, nullptr);
+		comp.value += 1;
+		ecsact_system_execution_context_update(ctx, comp_id, &comp, nullptr);
+	}
+}
+
+constexpr ecsact_system_execution_impl iterate_system_impls[] = {
+	&iterate_system_impl<1>,
+	&iterate_system_impl<2>,
+	&iterate_system_impl<3>,
+	&iterate_system_impl<4>,
+};
+
+void notify_system_impl(ecsact_system_execution_context*) {
+	notify_invocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+void damage_apply_system_impl(ecsact_system_execution_context* ctx) {
+	auto damage = bench_component{.value = 1};
+	ecsact_system_execution_context_add(
+		ctx,
+		ecsact_id_cast<ecsact_component_like_id>(schema.damage_transient),
+		&damage
+	);
+}
+
+void damage_resolve_system_impl(ecsact_system_execution_context* ctx) {
+	auto damage = bench_component{};
+	auto health = bench_component{};
+	ecsact_system_execution_context_get(
+		ctx,
+		ecsact_id_cast<ecsact_component_like_id>(schema.damage_transient),
+		&damage,
+		nullptr
+	);
+	ecsact_system_execution_context_get(
+		ctx,
+		as_comp(schema.health_component),
+		&health,
+		nullptr
+	);
+	health.value -= damage.value;
+	ecsact_system_execution_context_update(
+		ctx,
+		as_comp(schema.health_component),
+		&health,
+		nullptr
+	);
+}
+
+/**
+ * Declares every component and system used by the benchmarks. Systems are
+ * shared by every registry so each one only matches components unique to its
+ * workload.
+ */
+auto create_schema() -> void {
+	schema.package_id = ecsact_create_package(true, "bench", 5);
+
+	for(auto i = 0; max_iterate_components > i; ++i) {
+		auto n = std::to_string(i);
+		schema.components[i] = create_component("Component" + n);
+		schema.iterate_tags[i] = create_component("IterateTag" + n);
+	}
+
+	for(auto i = 0; max_iterate_components > i; ++i) {
+		auto sys_id = create_system("Iterate" + std::to_string(i + 1));
+		schema.iterate_systems[i] = sys_id;
+		ecsact_set_system_capability(
+			as_sys(sys_id),
+			as_comp(schema.iterate_tags[i]),
+			ECSACT_SYS_CAP_INCLUDE
+		);
+		for(auto c = 0; i >= c; ++c) {
+			ecsact_set_system_capability(
+				as_sys(sys_id),
+				as_comp(schema.components[c]),
+				ECSACT_SYS_CAP_READWRITE
+			);
+		}
+		ecsact_set_system_execution_impl(as_sys(sys_id), iterate_system_impls[i]);
+	}
+
+	schema.notify_component = create_component("Watched");
+	schema.notify_system = create_system("NotifyOnChange");
+	ecsact_set_system_capability(
+		as_sys(schema.notify_system),
+		as_comp(schema.notify_component),
+		ECSACT_SYS_CAP_READONLY
+	);
+	if(ecsact_set_system_notify_component_setting != nullptr) {
+		ecsact_set_system_notify_component_setting(
+			as_sys(schema.notify_system),
+			as_comp(schema.notify_component),
+			ECSACT_SYS_NOTIFY_ONCHANGE
+		);
+	}
+	ecsact_set_system_execution_impl(
+		as_sys(schema.notify_system),
+		&notify_system_impl
+	);
+
+	schema.stream_component = create_component("Streamed", ECSACT_F32);
+	if(ecsact_set_component_type != nullptr) {
+		ecsact_set_component_type(
+			schema.stream_component,
+			ECSACT_COMPONENT_TYPE_STREAM
+		);
+	}
+
+	schema.health_component = create_component("Health");
+	schema.damage_transient =
+		ecsact_create_transient(schema.package_id, "Damage", 6);
+	ecsact_add_field(
+		ecsact_id_cast<ecsact_composite_id>(schema.damage_transient),
+		ecsact_field_type{
+			.kind = ECSACT_TYPE_KIND_BUILTIN,
+			.type = {.builtin = ECSACT_I32},
+			.length = 1,
+		},
+		"value",
+		5
+	);
+
+	schema.damage_apply_system = create_system("DamageApply");
+	ecsact_set_system_capability(
+		as_sys(schema.damage_apply_system),
+		as_comp(schema.health_component),
+		ECSACT_SYS_CAP_INCLUDE
+	);
+	ecsact_set_system_capability(
+		as_sys(schema.damage_apply_system),
+		ecsact_id_cast<ecsact_component_like_id>(schema.damage_transient),
+		ECSACT_SYS_CAP_ADDS
+	);
+	ecsact_set_system_execution_impl(
+		as_sys(schema.damage_apply_system),
+		&damage_apply_system_impl
+	);
+
+	schema.damage_resolve_system = create_system("DamageResolve");
+	ecsact_set_system_capability(
+		as_sys(schema.damage_resolve_system),
+		as_comp(schema.health_component),
+		ECSACT_SYS_CAP_READWRITE
+	);
+	ecsact_set_system_capability(
+		as_sys(schema.damage_resolve_system),
+		ecsact_id_cast<ecsact_component_like_id>(schema.damage_transient),
+		ECSACT_SYS_CAP_READONLY
+	);
+	ecsact_set_system_execution_impl(
+		as_sys(schema.damage_resolve_system),
+		&damage_resolve_system_impl
+	);
+}
+
+auto create_entities( //
+	ecsact_registry_id reg_id,
+	int64_t            count
+) -> std::vector<ecsact_entity_id> {
+	auto entities = std::vector<ecsact_entity_id>{};
+	entities.reserve(count);
+	for(int64_t i = 0; count > i; ++i) {
+		entities.push_back(ecsact_create_entity(reg_id));
+	}
+	return entities;
+}
+
+auto add_to_all(
+	ecsact_registry_id                   reg_id,
+	const std::vector<ecsact_entity_id>& entities,
+	ecsact_component_id                  comp_id
+) -> void {
+	auto comp = bench_component{};
+	for(auto entity : entities) {
+		ecsact_add_component(reg_id, entity, comp_id, &comp);
+	}
+}
+
+auto execute_once(
+	ecsact_registry_id                       reg_id,
+	const ecsact_execution_events_collector* evc = nullptr
+) -> void {
+	ecsact_execute_systems(reg_id, 1, nullptr, evc);
+}
+
+/**
+ * Creates a registry with @p entity_count entities each with every iterate
+ * component. Used by the serialize workloads.
+ */
+auto create_populated_registry(int64_t entity_count) -> ecsact_registry_id {
+	auto reg_id = ecsact_create_registry("bench");
+	auto entities = create_entities(reg_id, entity_count);
+	for(auto comp_id : schema.components) {
+		add_to_all(reg_id, entities, comp_id);
+	}
+	return reg_id;
+}
+
+void BM_CreateDestroyEntities(benchmark::State& state) {
+	BENCH_REQUIRE_FN(state, ecsact_destroy_entity);
+
+	auto reg_id = ecsact_create_registry("bench");
+	auto entities = std::vector<ecsact_entity_id>{};
+	entities.resize(state.range(0));
+
+	for(auto _ : state) {
+		for(auto& entity : entities) {
+			entity = ecsact_create_entity(reg_id);
+		}
+		for(auto entity : entities) {
+			ecsact_destroy_entity(reg_id, entity);
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	ecsact_destroy_registry(reg_id);
+}
+
+BENCHMARK(BM_CreateDestroyEntities)->RangeMultiplier(10)->Range(1'000, 100'000);
+
+void BM_AddRemoveComponent(benchmark::State& state) {
+	BENCH_REQUIRE_FN(state, ecsact_remove_component);
+
+	auto reg_id = ecsact_create_registry("bench");
+	auto entities = create_entities(reg_id, state.range(0));
+	auto comp_id = schema.components[0];
+	auto comp = bench_component{};
+
+	for(auto _ : state) {
+		for(auto entity : entities) {
+			ecsact_add_component(reg_id, entity, comp_id, &comp);
+		}
+		for(auto entity : entities) {
+			ecsact_remove_component(reg_id, entity, comp_id, nullptr);
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	ecsact_destroy_registry(reg_id);
+}
+
+BENCHMARK(BM_AddRemoveComponent)->RangeMultiplier(10)->Range(1'000, 100'000);
+
+void BM_IterateEntities(benchmark::State& state) {
+	auto component_count = static_cast<int>(state.range(0));
+	auto entity_count = state.range(1);
+	auto reg_id = ecsact_create_registry("bench");
+	auto entities = create_entities(reg_id, entity_count);
+
+	add_to_all(reg_id, entities, schema.iterate_tags[component_count - 1]);
+	for(auto i = 0; component_count > i; ++i) {
+		add_to_all(reg_id, entities, schema.components[i]);
+	}
+
+	for(auto _ : state) {
+		execute_once(reg_id);
+	}
+
+	state.SetItemsProcessed(state.iterations() * entity_count);
+	ecsact_destroy_registry(reg_id);
+}
+
+BENCHMARK(BM_IterateEntities)
+	->ArgNames({"components", "entities"})
+	->ArgsProduct({{1, 2, 3, 4}, {1 << 20}})
+	->Unit(benchmark::kMillisecond);
+
+void count_component_event(
+	ecsact_event,
+	ecsact_entity_id,
+	ecsact_component_id,
+	const void*,
+	void* callback_user_data
+) {
+	*static_cast<int64_t*>(callback_user_data) += 1;
+}
+
+void BM_EventsCollection(benchmark::State& state) {
+	auto entity_count = state.range(0);
+	auto reg_id = ecsact_create_registry("bench");
+	auto entities = create_entities(reg_id, entity_count);
+	add_to_all(reg_id, entities, schema.iterate_tags[0]);
+	add_to_all(reg_id, entities, schema.components[0]);
+
+	auto event_count = int64_t{};
+	auto evc = ecsact_execution_events_collector{};
+	evc.update_callback = &count_component_event;
+	evc.update_callback_user_data = &event_count;
+
+	for(auto _ : state) {
+		execute_once(reg_id, &evc);
+	}
+
+	state.counters["events"] = benchmark::Counter(
+		static_cast<double>(event_count),
+		benchmark::Counter::kIsRate
+	);
+	ecsact_destroy_registry(reg_id);
+}
+
+BENCHMARK(BM_EventsCollection)
+	->RangeMultiplier(10)
+	->Range(1'000, 1'000'000)
+	->Unit(benchmark::kMillisecond);
+
+/**
+ * Change tracking: only 1% of entities are updated between executions so a
+ * runtime that tracks dirty components should only invoke the ONCHANGE system
+ * for those entities.
+ */
+void BM_NotifyOnChange(benchmark::State& state) {
+	BENCH_REQUIRE_FN(state, ecsact_set_system_notify_component_setting);
+	BENCH_REQUIRE_FN(state, ecsact_update_component);
+
+	auto entity_count = state.range(0);
+	auto reg_id = ecsact_create_registry("bench");
+	auto entities = create_entities(reg_id, entity_count);
+	add_to_all(reg_id, entities, schema.notify_component);
+	execute_once(reg_id);
+
+	auto changed_count = std::max<int64_t>(entity_count / 100, 1);
+	auto stride = entity_count / changed_count;
+	auto value = int32_t{};
+
+	notify_invocations = 0;
+	for(auto _ : state) {
+		value += 1;
+		for(int64_t i = 0; changed_count > i; ++i) {
+			auto comp = bench_component{.value = value};
+			ecsact_update_component(
+				reg_id,
+				entities[i * stride],
+				schema.notify_component,
+				&comp,
+				nullptr
+			);
+		}
+		execute_once(reg_id);
+	}
+
+	state.counters["invocations_per_exec"] = benchmark::Counter(
+		static_cast<double>(notify_invocations.load()),
+		benchmark::Counter::kAvgIterations
+	);
+	ecsact_destroy_registry(reg_id);
+}
+
+BENCHMARK(BM_NotifyOnChange)
+	->RangeMultiplier(10)
+	->Range(10'000, 1'000'000)
+	->Unit(benchmark::kMillisecond);
+
+struct stream_bench_state {
+	ecsact_registry_id            reg_id;
+	std::vector<ecsact_entity_id> entities;
+};
+
+auto stream_state = stream_bench_state{};
+
+/**
+ * Multiple producer threads streaming into the same registry while the main
+ * thread executes systems.
+ */
+void BM_StreamProducers(benchmark::State& state) {
+	constexpr auto entity_count = 10'000;
+
+	BENCH_REQUIRE_FN(state, ecsact_set_component_type);
+	BENCH_REQUIRE_FN(state, ecsact_stream);
+
+	if(state.thread_index() == 0) {
+		stream_state.reg_id = ecsact_create_registry("bench");
+		stream_state.entities = create_entities(stream_state.reg_id, entity_count);
+		add_to_all(
+			stream_state.reg_id,
+			stream_state.entities,
+			schema.stream_component
+		);
+	}
+
+	auto index = static_cast<size_t>(state.thread_index());
+	auto value = 0.f;
+	for(auto _ : state) {
+		auto entity = stream_state.entities[index % entity_count];
+		index += static_cast<size_t>(state.threads());
+		value += 1.f;
+		ecsact_stream(
+			stream_state.reg_id,
+			entity,
+			schema.stream_component,
+			&value,
+			nullptr
+		);
+		auto wrapped = index % entity_count < static_cast<size_t>(state.threads());
+		if(state.thread_index() == 0 && wrapped) {
+			execute_once(stream_state.reg_id);
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations());
+
+	if(state.thread_index() == 0) {
+		ecsact_destroy_registry(stream_state.reg_id);
+	}
+}
+
+BENCHMARK(BM_StreamProducers)->ThreadRange(1, 8)->UseRealTime();
+
+/**
+ * Transient damage event added and consumed by every entity each execution.
+ */
+void BM_TransientDamage(benchmark::State& state) {
+	auto entity_count = state.range(0);
+	auto reg_id = ecsact_create_registry("bench");
+	auto entities = create_entities(reg_id, entity_count);
+	auto health = bench_component{.value = 1'000'000};
+	for(auto entity : entities) {
+		ecsact_add_component(reg_id, entity, schema.health_component, &health);
+	}
+
+	for(auto _ : state) {
+		execute_once(reg_id);
+	}
+
+	state.SetItemsProcessed(state.iterations() * entity_count);
+	ecsact_destroy_registry(reg_id);
+}
+
+BENCHMARK(BM_TransientDamage)->Arg(100'000)->Unit(benchmark::kMillisecond);
+
+void dump_to_vector(const void* data, int32_t data_length, void* user_data) {
+	auto& out = *static_cast<std::vector<std::byte>*>(user_data);
+	auto  bytes = static_cast<const std::byte*>(data);
+	out.insert(out.end(), bytes, bytes + data_length);
+}
+
+struct restore_reader {
+	const std::vector<std::byte>* data;
+	size_t                        offset;
+};
+
+int32_t restore_from_vector(
+	void*   out_data,
+	int32_t data_max_length,
+	void*   user_data
+) {
+	auto& reader = *static_cast<restore_reader*>(user_data);
+	auto  remaining = reader.data->size() - reader.offset;
+	auto  read_length =
+		std::min(remaining, static_cast<size_t>(data_max_length));
+	std::memcpy(out_data, reader.data->data() + reader.offset, read_length);
+	reader.offset += read_length;
+	return static_cast<int32_t>(read_length);
+}
+
+void BM_DumpEntities(benchmark::State& state) {
+	BENCH_REQUIRE_FN(state, ecsact_dump_entities);
+
+	auto reg_id = create_populated_registry(state.range(0));
+	auto dumped = std::vector<std::byte>{};
+
+	for(auto _ : state) {
+		dumped.clear();
+		ecsact_dump_entities(reg_id, &dump_to_vector, &dumped);
+		benchmark::DoNotOptimize(dumped.data());
+	}
+
+	state.SetBytesProcessed(state.iterations() * dumped.size());
+	ecsact_destroy_registry(reg_id);
+}
+
+BENCHMARK(BM_DumpEntities)
+	->RangeMultiplier(10)
+	->Range(1'000, 1'000'000)
+	->Unit(benchmark::kMillisecond);
+
+void BM_RestoreEntities(benchmark::State& state) {
+	BENCH_REQUIRE_FN(state, ecsact_dump_entities);
+	BENCH_REQUIRE_FN(state, ecsact_restore_entities);
+
+	auto reg_id = create_populated_registry(state.range(0));
+	auto dumped = std::vector<std::byte>{};
+	ecsact_dump_entities(reg_id, &dump_to_vector, &dumped);
+
+	for(auto _ : state) {
+		auto reader = restore_reader{&dumped, 0};
+		auto err =
+			ecsact_restore_entities(reg_id, &restore_from_vector, nullptr, &reader);
+		if(err != ECSACT_RESTORE_OK) {
+			state.SkipWithError("ecsact_restore_entities failed");
+			break;
+		}
+	}
+
+	state.SetBytesProcessed(state.iterations() * dumped.size());
+	ecsact_destroy_registry(reg_id);
+}
+
+BENCHMARK(BM_RestoreEntities)
+	->RangeMultiplier(10)
+	->Range(1'000, 1'000'000)
+	->Unit(benchmark::kMillisecond);
+
+void dump_segments_to_vector(
+	const ecsact_dump_segment* segments,
+	int32_t                    segments_count,
+	void*                      user_data
+) {
+	auto& out = *static_cast<std::vector<std::byte>*>(user_data);
+	for(auto i = 0; segments_count > i; ++i) {
+		const auto& segment = segments[i];
+		out.resize(segment.offset + segment.length);
+		std::memcpy(out.data() + segment.offset, segment.data, segment.length);
+	}
+}
+
+int64_t read_range_from_vector(
+	void*   out_data,
+	int64_t offset,
+	int64_t length,
+	void*   user_data
+) {
+	auto& dumped = *static_cast<const std::vector<std::byte>*>(user_data);
+	auto  size = static_cast<int64_t>(dumped.size());
+	if(offset < 0 || length < 0 || offset > size) {
+		return -1;
+	}
+
+	// A short read stops the restore with an error instead of reading past the
+	// dump
+	auto read_length = std::min(length, size - offset);
+	std::memcpy(out_data, dumped.data() + offset, read_length);
+	return read_length;
+}
+
+void count_segment_bytes(
+	const ecsact_dump_segment* segments,
+	int32_t                    segments_count,
+	void*                      user_data
+) {
+	auto& total = *static_cast<int64_t*>(user_data);
+	for(auto i = 0; segments_count > i; ++i) {
+		total += segments[i].length;
+	}
+}
+
+/**
+ * Range 0: @ref ecsact_dump_columns_mode
+ */
+void BM_DumpEntitiesColumns(benchmark::State& state) {
+	BENCH_REQUIRE_FN(state, ecsact_dump_entities_columns);
+
+	auto mode = static_cast<ecsact_dump_columns_mode>(state.range(0));
+	auto reg_id = create_populated_registry(state.range(1));
+	auto total = int64_t{};
+
+	for(auto _ : state) {
+		ecsact_dump_entities_columns(reg_id, mode, &count_segment_bytes, &total);
+	}
+
+	state.SetBytesProcessed(total);
+	ecsact_destroy_registry(reg_id);
+}
+
+BENCHMARK(BM_DumpEntitiesColumns)
+	->ArgNames({"mode", "entities"})
+	->ArgsProduct({
+		{ECSACT_DUMP_COLUMNS_VIEW, ECSACT_DUMP_COLUMNS_ALIGNED},
+		{1'000'000},
+	})
+	->Unit(benchmark::kMillisecond);
+
+void BM_RestoreEntitiesParallel(benchmark::State& state) {
+	BENCH_REQUIRE_FN(state, ecsact_dump_entities_columns);
+	BENCH_REQUIRE_FN(state, ecsact_restore_entities_parallel);
+
+	auto reg_id = create_populated_registry(state.range(1));
+	auto dumped = std::vector<std::byte>{};
+	ecsact_dump_entities_columns(
+		reg_id,
+		ECSACT_DUMP_COLUMNS_VIEW,
+		&dump_segments_to_vector,
+		&dumped
+	);
+
+	for(auto _ : state) {
+		auto err = ecsact_restore_entities_parallel(
+			reg_id,
+			&read_range_from_vector,
+			&dumped,
+			static_cast<int32_t>(state.range(0)),
+			nullptr
+		);
+		if(err != ECSACT_RESTORE_OK) {
+			state.SkipWithError("ecsact_restore_entities_parallel failed");
+			break;
+		}
+	}
+
+	state.SetBytesProcessed(state.iterations() * dumped.size());
+	ecsact_destroy_registry(reg_id);
+}
+
+BENCHMARK(BM_RestoreEntitiesParallel)
+	->ArgNames({"threads", "entities"})
+	->ArgsProduct({{1, 2, 4, 8}, {1'000'000}})
+	->UseRealTime()
+	->Unit(benchmark::kMillisecond);
+
+} // namespace
+
+auto main(int argc, char** argv) -> int {
+	constexpr auto runtime_flag = std::string_view{"--ecsact_runtime="};
+
+	auto runtime_path = std::string{};
+	if(auto env_runtime_path = std::getenv("ECSACT_RUNTIME"); env_runtime_path) {
+		runtime_path = env_runtime_path;
+	}
+
+	auto benchmark_args = std::vector<char*>{};
+	for(auto i = 0; argc > i; ++i) {
+		auto arg = std::string_view{argv[i]};
+		if(arg.starts_with(runtime_flag)) {
+			runtime_path = arg.substr(runtime_flag.size());
+		} else {
+			benchmark_args.push_back(argv[i]);
+		}
+	}
+
+	if(runtime_path.empty()) {
+		std::cerr << "Usage: " << argv[0]
+							<< " --ecsact_runtime=<path> [benchmark flags]\n";
+		return 1;
+	}
+
+	if(!load_runtime(runtime_path) || !required_fns_loaded()) {
+		return 1;
+	}
+
+	create_schema();
+
+	auto benchmark_argc = static_cast<int>(benchmark_args.size());
+	benchmark::Initialize(&benchmark_argc, benchmark_args.data());
+	auto unrecognized_args = benchmark::ReportUnrecognizedArguments(
+		benchmark_argc,
+		benchmark_args.data()
+	);
+	if(unrecognized_args) {
+		return 1;
+	}
+
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+	return 0;
+}
@@ -0,0 +1,111 @@
+#include <array>
+#include <vector>
+#include "gtest/gtest.h"
+#include "ecsact/runtime/determinism.hh"
+#include "async_local_fake_runtime.hh"
+
+using ecsact::core::check_determinism;
+using ecsact::test::fake_position;
+using ecsact::test::fake_position_id;
+
+namespace {
+
+constexpr auto thread_counts = std::array<int32_t, 3>{1, 2, 4};
+
+/**
+ * Execution options adding or updating a single @ref fake_position
+ */
+struct position_options {
+	ecsact_entity_id         entity;
+	fake_position            data;
+	ecsact_component         component;
+	ecsact_execution_options options{};
+
+	position_options(ecsact_entity_id entity, int32_t value, bool add = false)
+		: entity(entity), data{value}, component{fake_position_id, &data} {
+		if(add) {
+			options.add_components_length = 1;
+			options.add_components_entities = &this->entity;
+			options.add_components = &component;
+		} else {
+			options.update_components_length = 1;
+			options.update_components_entities = &this->entity;
+			options.update_components = &component;
+		}
+	}
+
+	position_options(const position_options&) = delete;
+};
+
+auto add_position(
+	ecsact_registry_id reg_id,
+	ecsact_entity_id   entity,
+	int32_t            value
+) -> void {
+	auto add = position_options{entity, value, true};
+	ecsact_execute_systems(reg_id, 1, &add.options, nullptr);
+}
+} // namespace
+
+TEST(CheckDeterminism, MatchesForEveryThreadCount) {
+	auto first = position_options{static_cast<ecsact_entity_id>(1), 10};
+	auto second = position_options{static_cast<ecsact_entity_id>(2), 20};
+	auto execution_options_list = std::vector{first.options, second.options};
+
+	auto result = check_determinism(
+		std::span<const ecsact_execution_options>{execution_options_list},
+		std::span<const int32_t>{thread_counts},
+		[](ecsact_registry_id reg_id) {
+			add_position(reg_id, static_cast<ecsact_entity_id>(1), 0);
+			add_position(reg_id, static_cast<ecsact_entity_id>(2), 0);
+		}
+	);
+
+	EXPECT_TRUE(result.ok());
+	ASSERT_EQ(result.hashes.size(), thread_counts.size());
+	for(auto& hashes : result.hashes) {
+		ASSERT_EQ(hashes.size(), execution_options_list.size());
+		EXPECT_NE(hashes[0], hashes[1]);
+	}
+}
+
+TEST(CheckDeterminism, ReportsFirstMismatch) {
+	auto update = position_options{static_cast<ecsact_entity_id>(1), 10};
+	auto execution_options_list = std::vector{update.options};
+
+	// Every registry gets a different extra entity so no hash can match
+	auto setup_count = 0;
+	auto result = check_determinism(
+		std::span<const ecsact_execution_options>{execution_options_list},
+		std::span<const int32_t>{thread_counts},
+		[&](ecsact_registry_id reg_id) {
+			add_position(reg_id, static_cast<ecsact_entity_id>(2), setup_count++);
+		}
+	);
+
+	EXPECT_FALSE(result.ok());
+	EXPECT_EQ(result.execute_error, ECSACT_EXEC_SYS_OK);
+	ASSERT_TRUE(result.first_mismatch_index.has_value());
+	EXPECT_EQ(*result.first_mismatch_index, 0);
+}
+
+TEST(CheckDeterminism, StopsAtExecuteError) {
+	// The fake package has no actions so any action fails to execute
+	auto action = ecsact_action{};
+	auto options = ecsact_execution_options{};
+	options.actions_length = 1;
+	options.actions = &action;
+	auto execution_options_list = std::vector{options};
+
+	auto result = check_determinism(
+		std::span<const ecsact_execution_options>{execution_options_list},
+		std::span<const int32_t>{thread_counts},
+		[](ecsact_registry_id) {}
+	);
+
+	EXPECT_FALSE(result.ok());
+	EXPECT_EQ(result.execute_error, ECSACT_EXEC_SYS_ERR_ACTION_ENTITY_INVALID);
+	EXPECT_FALSE(result.first_mismatch_index.has_value());
+	ASSERT_EQ(result.hashes.size(), 1);
+	EXPECT_TRUE(result.hashes[0].empty());
+}
@@ -0,0 +1,172 @@
+/**
+ * Measures the cost of calling runtime API functions through the function
+ * pointers set by `ecsact_dylib_set_fn_addr` compared to calling the same
+ * function directly as a statically linked runtime would. Also measures how
+ * long binding every function takes.
+ *
+ * The runtime functions are stubs so only the call overhead is measured.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "benchmark/benchmark.h"
+#include "ecsact/runtime.h"
+#include "ecsact/runtime/dylib.h"
+
+#ifdef _MSC_VER
+#	define BENCH_NOINLINE __declspec(noinline)
+#else
+#	define BENCH_NOINLINE __attribute__((noinline))
+#endif
+
+namespace {
+
+struct stub_component {
+	int32_t value;
+};
+
+auto stub_storage = stub_component{};
+
+BENCH_NOINLINE const void* stub_get_component(
+	ecsact_registry_id,
+	ecsact_entity_id,
+	ecsact_component_id,
+	const void*
+) {
+	return &stub_storage;
+}
+
+BENCH_NOINLINE void stub_context_get(
+	ecsact_system_execution_context*,
+	ecsact_component_like_id,
+	void* out_component_data,
+	const void*
+) {
+	std::memcpy(out_component_data, &stub_storage, sizeof(stub_component));
+}
+
+BENCH_NOINLINE void stub_context_update(
+	ecsact_system_execution_context*,
+	ecsact_component_like_id,
+	const void* component_data,
+	const void*
+) {
+	std::memcpy(&stub_storage, component_data, sizeof(stub_component));
+}
+
+BENCH_NOINLINE void stub_noop() {
+}
+
+auto bind_stubs() -> void {
+	ecsact_dylib_set_fn_addr(
+		"ecsact_get_component",
+		reinterpret_cast<ecsact_dylib_fn>(&stub_get_component)
+	);
+	ecsact_dylib_set_fn_addr(
+		"ecsact_system_execution_context_get",
+		reinterpret_cast<ecsact_dylib_fn>(&stub_context_get)
+	);
+	ecsact_dylib_set_fn_addr(
+		"ecsact_system_execution_context_update",
+		reinterpret_cast<ecsact_dylib_fn>(&stub_context_update)
+	);
+}
+
+void BM_DirectGetComponent(benchmark::State& state) {
+	for(auto _ : state) {
+		auto data = stub_get_component({}, {}, {}, nullptr);
+		benchmark::DoNotOptimize(data);
+	}
+}
+
+BENCHMARK(BM_DirectGetComponent);
+
+void BM_DylibGetComponent(benchmark::State& state) {
+	bind_stubs();
+	for(auto _ : state) {
+		auto data = ecsact_get_component({}, {}, {}, nullptr);
+		benchmark::DoNotOptimize(data);
+	}
+}
+
+BENCHMARK(BM_DylibGetComponent);
+
+/**
+ * Typical system impl body: get a component, modify it and update it.
+ */
+void BM_DirectContextGetUpdate(benchmark::State& state) {
+	auto comp = stub_component{};
+	for(auto _ : state) {
+		stub_context_get(nullptr, {}, &comp, nullptr);
+		comp.value += 1;
+		stub_context_update(nullptr, {}, &comp, nullptr);
+	}
+	benchmark::DoNotOptimize(comp);
+}
+
+BENCHMARK(BM_DirectContextGetUpdate);
+
+void BM_DylibContextGetUpdate(benchmark::State& state) {
+	bind_stubs();
+	auto comp = stub_component{};
+	for(auto _ : state) {
+		ecsact_system_execution_context_get(nullptr, {}, &comp, nullptr);
+		comp.value += 1;
+		ecsact_system_execution_context_update(nullptr, {}, &comp, nullptr);
+	}
+	benchmark::DoNotOptimize(comp);
+}
+
+BENCHMARK(BM_DylibContextGetUpdate);
+
+auto settable_fn_names() -> std::vector<const char*> {
+	auto names = std::vector<const char*>{};
+#define PUSH_FN_NAME(fn_name, names)    \
+	if(ecsact_dylib_has_fn(#fn_name)) { \
+		names.push_back(#fn_name);        \
+	}                                   \
+	static_assert(true, "macro requires ;")
+
+	FOR_EACH_ECSACT_API_FN(PUSH_FN_NAME, names);
+
+#undef PUSH_FN_NAME
+	return names;
+}
+
+/**
+ * Binding every function one at a time by name
+ */
+void BM_BindFnAddr(benchmark::State& state) {
+	auto names = settable_fn_names();
+	for(auto _ : state) {
+		for(auto name : names) {
+			ecsact_dylib_set_fn_addr(name, &stub_noop);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * names.size());
+	bind_stubs();
+}
+
+BENCHMARK(BM_BindFnAddr);
+
+/**
+ * Binding every function with a single `ecsact_dylib_set_fn_addrs` call
+ */
+void BM_BindFnAddrs(benchmark::State& state) {
+	auto names = settable_fn_names();
+	auto fn_ptrs = std::vector<ecsact_dylib_fn>(names.size(), &stub_noop);
+	for(auto _ : state) {
+		ecsact_dylib_set_fn_addrs(
+			names.data(),
+			fn_ptrs.data(),
+			static_cast<int32_t>(names.size())
+		);
+	}
+	state.SetItemsProcessed(state.iterations() * names.size());
+	bind_stubs();
+}
+
+BENCHMARK(BM_BindFnAddrs);
+
+} // namespace
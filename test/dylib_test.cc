@@ -0,0 +1,124 @@
+#include <cstdint>
+#include <set>
+#include <string_view>
+#include <vector>
+#include "gtest/gtest.h"
+#include "ecsact/runtime.h"
+#include "ecsact/runtime/dylib.h"
+
+namespace {
+
+/**
+ * A runtime API function name and a way to read the function pointer the
+ * dylib assigns for it
+ */
+struct api_fn {
+	const char* name;
+	ecsact_dylib_fn (*get)();
+};
+
+#define PUSH_API_FN(fn_name, fns)                               \
+	fns.push_back(api_fn{                                         \
+		#fn_name,                                                   \
+		+[] { return reinterpret_cast<ecsact_dylib_fn>(fn_name); }, \
+	})
+
+/**
+ * Every function of the modules `dylib:full` loads at runtime
+ */
+auto dylib_api_fns() -> std::vector<api_fn> {
+	auto fns = std::vector<api_fn>{};
+	FOR_EACH_ECSACT_ASYNC_API_FN(PUSH_API_FN, fns);
+	FOR_EACH_ECSACT_CORE_API_FN(PUSH_API_FN, fns);
+	FOR_EACH_ECSACT_DYNAMIC_API_FN(PUSH_API_FN, fns);
+	FOR_EACH_ECSACT_META_API_FN(PUSH_API_FN, fns);
+	FOR_EACH_ECSACT_PROFILE_API_FN(PUSH_API_FN, fns);
+	FOR_EACH_ECSACT_SERIALIZE_API_FN(PUSH_API_FN, fns);
+	return fns;
+}
+
+/**
+ * Distinct address per function. Never called.
+ */
+auto fake_fn_addr(size_t index) -> ecsact_dylib_fn {
+	return reinterpret_cast<ecsact_dylib_fn>(
+		static_cast<uintptr_t>(0x1000 + index * 0x10)
+	);
+}
+
+class Dylib : public testing::Test {
+protected:
+	void TearDown() override {
+		for(auto& fn : dylib_api_fns()) {
+			ecsact_dylib_set_fn_addr(fn.name, nullptr);
+		}
+	}
+};
+} // namespace
+
+TEST_F(Dylib, EveryApiFnNameIsUnique) {
+	auto fns = dylib_api_fns();
+	auto names = std::set<std::string_view>{};
+	for(auto& fn : fns) {
+		EXPECT_TRUE(names.insert(fn.name).second) << fn.name;
+	}
+}
+
+TEST_F(Dylib, EveryApiFnResolves) {
+	auto fns = dylib_api_fns();
+	for(size_t i = 0; fns.size() > i; ++i) {
+		EXPECT_TRUE(ecsact_dylib_has_fn(fns[i].name)) << fns[i].name;
+		ecsact_dylib_set_fn_addr(fns[i].name, fake_fn_addr(i));
+	}
+
+	// Checked after every function is set so two names binding the same
+	// function pointer are caught
+	for(size_t i = 0; fns.size() > i; ++i) {
+		EXPECT_EQ(fns[i].get(), fake_fn_addr(i)) << fns[i].name;
+	}
+}
+
+TEST_F(Dylib, RejectsUnknownNames) {
+	auto unknown_names = {
+		"",
+		"a",
+		"ecsact_",
+		"ecsact_create",
+		"ecsact_create_registryx",
+		"ecsact_not_a_function",
+		"zzz",
+	};
+	for(auto name : unknown_names) {
+		EXPECT_FALSE(ecsact_dylib_has_fn(name)) << name;
+	}
+
+	// Unknown names are ignored without touching known functions
+	ecsact_dylib_set_fn_addr("ecsact_create", fake_fn_addr(0));
+	ecsact_dylib_set_fn_addr("ecsact_not_a_function", fake_fn_addr(0));
+	for(auto& fn : dylib_api_fns()) {
+		EXPECT_EQ(fn.get(), nullptr) << fn.name;
+	}
+}
+
+TEST_F(Dylib, SetFnAddrsBindsKnownNames) {
+	const char* names[] = {
+		"ecsact_create_registry",
+		"ecsact_not_a_function",
+		"ecsact_async_flush_events",
+	};
+	ecsact_dylib_fn fn_ptrs[] = {
+		fake_fn_addr(1),
+		fake_fn_addr(2),
+		fake_fn_addr(3),
+	};
+	ecsact_dylib_set_fn_addrs(names, fn_ptrs, 3);
+
+	EXPECT_EQ(
+		reinterpret_cast<ecsact_dylib_fn>(ecsact_create_registry),
+		fake_fn_addr(1)
+	);
+	EXPECT_EQ(
+		reinterpret_cast<ecsact_dylib_fn>(ecsact_async_flush_events),
+		fake_fn_addr(3)
+	);
+}
@@ -0,0 +1,258 @@
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+#include "gtest/gtest.h"
+#include "ecsact/runtime/core.h"
+#include "ecsact/runtime/meta.h"
+#include "ecsact/runtime/serialize.h"
+#include "replay/player.hh"
+#include "replay/recorder.hh"
+#include "async_local_fake_runtime.hh"
+
+using ecsact::replay::player;
+using ecsact::replay::recorder;
+using ecsact::test::fake_position;
+using ecsact::test::fake_position_id;
+namespace format = ecsact::replay::format;
+
+// The fake runtime has no serialize module. Positions are serialized as-is
+// and keyframes are empty since they are not played by these tests.
+
+uint64_t ecsact_meta_schema_hash() {
+	return 0xEC5AC7;
+}
+
+int ecsact_serialize_action_size(ecsact_action_id) {
+	return 0;
+}
+
+int ecsact_serialize_component_size(ecsact_component_id component_id) {
+	return component_id == fake_position_id ? sizeof(fake_position) : 0;
+}
+
+int ecsact_serialize_action(ecsact_action_id, const void*, uint8_t*) {
+	return 0;
+}
+
+int ecsact_deserialize_action(ecsact_action_id, const uint8_t*, void*) {
+	return 0;
+}
+
+int ecsact_serialize_component(
+	ecsact_component_id component_id,
+	const void*         in_component_data,
+	uint8_t*            out_bytes
+) {
+	auto size = ecsact_serialize_component_size(component_id);
+	std::memcpy(out_bytes, in_component_data, size);
+	return size;
+}
+
+int ecsact_deserialize_component(
+	ecsact_component_id component_id,
+	const uint8_t*      in_bytes,
+	void*               out_component_data
+) {
+	auto size = ecsact_serialize_component_size(component_id);
+	std::memcpy(out_component_data, in_bytes, size);
+	return size;
+}
+
+void ecsact_dump_entities(
+	ecsact_registry_id,
+	ecsact_dump_entities_callback,
+	void*
+) {
+}
+
+ecsact_restore_error ecsact_restore_entities(
+	ecsact_registry_id,
+	ecsact_restore_entities_callback,
+	const ecsact_execution_events_collector*,
+	void*
+) {
+	return ECSACT_RESTORE_OK;
+}
+
+namespace {
+
+/**
+ * Execution options adding or updating a single @ref fake_position
+ */
+struct position_options {
+	ecsact_entity_id         entity;
+	fake_position            data;
+	ecsact_component         component;
+	ecsact_execution_options options{};
+
+	position_options(ecsact_entity_id entity, int32_t value, bool add = false)
+		: entity(entity), data{value}, component{fake_position_id, &data} {
+		if(add) {
+			options.add_components_length = 1;
+			options.add_components_entities = &this->entity;
+			options.add_components = &component;
+		} else {
+			options.update_components_length = 1;
+			options.update_components_entities = &this->entity;
+			options.update_components = &component;
+		}
+	}
+
+	position_options(const position_options&) = delete;
+};
+
+auto log_path(const char* name) -> std::filesystem::path {
+	return std::filesystem::path{testing::TempDir()} / name;
+}
+
+/**
+ * Records 3 ticks into @p path while executing them on @p reg_id: adding 2
+ * positions, updating one and streaming the other
+ */
+auto record_log(const std::filesystem::path& path, ecsact_registry_id reg_id)
+	-> void {
+	auto rec = recorder{recorder::options{.output_path = path}};
+	ASSERT_TRUE(rec.is_open());
+
+	auto first = position_options{static_cast<ecsact_entity_id>(1), 10, true};
+	auto second = position_options{static_cast<ecsact_entity_id>(2), 20, true};
+	auto update = position_options{static_cast<ecsact_entity_id>(1), 30};
+	auto streamed = fake_position{40};
+
+	rec.record_execution_options(reg_id, 0, first.options);
+	ecsact_execute_systems(reg_id, 1, &first.options, nullptr);
+	rec.record_execution_options(reg_id, 1, second.options);
+	ecsact_execute_systems(reg_id, 1, &second.options, nullptr);
+	rec.record_stream(1, second.entity, fake_position_id, &streamed);
+	rec.record_execution_options(reg_id, 2, update.options);
+	ecsact_execute_systems(reg_id, 1, &update.options, nullptr);
+}
+
+/**
+ * Writes a log with a single record and no index
+ */
+auto write_log(
+	const std::filesystem::path&  path,
+	format::record_kind           kind,
+	const std::vector<std::byte>& payload
+) -> void {
+	auto file = std::ofstream{path, std::ios::binary | std::ios::trunc};
+	auto header = format::file_header{
+		.magic = format::file_magic,
+		.version = format::file_version,
+		.schema_hash = ecsact_meta_schema_hash(),
+	};
+	auto record = format::record_header{
+		.kind = kind,
+		.reserved = 0,
+		.tick = 0,
+		.payload_size = static_cast<int64_t>(payload.size()),
+	};
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+	file.write(reinterpret_cast<const char*>(payload.data()), payload.size());
+
+	// Padding so the file is large enough to be opened without a footer
+	auto padding = std::vector<char>(sizeof(format::index_footer));
+	file.write(padding.data(), padding.size());
+}
+
+template<typename T>
+auto append(std::vector<std::byte>& payload, const T& value) -> void {
+	auto bytes = reinterpret_cast<const std::byte*>(&value);
+	payload.insert(payload.end(), bytes, bytes + sizeof(T));
+}
+} // namespace
+
+TEST(Replay, PlaysRecordedLog) {
+	auto path = log_path("plays_recorded_log.ecrp");
+	auto recorded_reg = ecsact_create_registry("recorded");
+	record_log(path, recorded_reg);
+
+	auto played_reg = ecsact_create_registry("played");
+	auto streams_before = ecsact::test::fake_stream_count();
+	auto replay = player{path};
+	ASSERT_TRUE(replay.is_open());
+	EXPECT_TRUE(replay.schema_matches());
+
+	auto stats = replay.play(played_reg);
+	EXPECT_EQ(stats.error, player::play_error::ok);
+	EXPECT_EQ(stats.executions, 3);
+	EXPECT_EQ(stats.streams, 1);
+	EXPECT_EQ(ecsact::test::fake_stream_count() - streams_before, 1);
+	EXPECT_EQ(
+		ecsact_hash_registry(played_reg),
+		ecsact_hash_registry(recorded_reg)
+	);
+	EXPECT_FALSE(replay.step(played_reg));
+	EXPECT_EQ(replay.last_error(), player::play_error::ok);
+}
+
+TEST(Replay, StopsAtTruncatedRecord) {
+	auto path = log_path("stops_at_truncated_record.ecrp");
+	auto recorded_reg = ecsact_create_registry("recorded");
+	record_log(path, recorded_reg);
+
+	// Cut the log in the middle of its last execution options record. The
+	// footer is lost so the player reads up to the end of the file.
+	auto index_size =
+		sizeof(format::record_header) + sizeof(format::index_footer);
+	auto truncated_size = std::filesystem::file_size(path) - index_size - 4;
+	std::filesystem::resize_file(path, truncated_size);
+
+	auto played_reg = ecsact_create_registry("played");
+	auto replay = player{path};
+	ASSERT_TRUE(replay.is_open());
+
+	auto stats = replay.play(played_reg);
+	EXPECT_EQ(stats.error, player::play_error::truncated_record);
+	EXPECT_EQ(stats.executions, 2);
+	EXPECT_EQ(stats.streams, 1);
+	EXPECT_FALSE(replay.step(played_reg));
+
+	replay.rewind();
+	EXPECT_EQ(replay.last_error(), player::play_error::ok);
+}
+
+TEST(Replay, StopsAtTruncatedPayload) {
+	auto path = log_path("stops_at_truncated_payload.ecrp");
+
+	// Add count larger than the payload
+	auto payload = std::vector<std::byte>{};
+	append(payload, int32_t{1000});
+	append(payload, static_cast<ecsact_entity_id>(1));
+	write_log(path, format::record_kind::execution_options, payload);
+
+	auto reg_id = ecsact_create_registry("played");
+	auto executions_before = ecsact::test::fake_execute_count();
+	auto replay = player{path};
+	ASSERT_TRUE(replay.is_open());
+
+	auto stats = replay.play(reg_id);
+	EXPECT_EQ(stats.error, player::play_error::truncated_payload);
+	EXPECT_EQ(stats.executions, 0);
+	EXPECT_EQ(ecsact::test::fake_execute_count(), executions_before);
+}
+
+TEST(Replay, StopsAtSerializedSizeMismatch) {
+	auto path = log_path("stops_at_serialized_size_mismatch.ecrp");
+
+	// Stream record declaring fewer bytes than a position serializes to
+	auto payload = std::vector<std::byte>{};
+	append(payload, static_cast<ecsact_entity_id>(1));
+	append(payload, fake_position_id);
+	append(payload, int32_t{2});
+	append(payload, int16_t{0});
+	write_log(path, format::record_kind::stream, payload);
+
+	auto reg_id = ecsact_create_registry("played");
+	auto streams_before = ecsact::test::fake_stream_count();
+	auto replay = player{path};
+	ASSERT_TRUE(replay.is_open());
+
+	auto stats = replay.play(reg_id);
+	EXPECT_EQ(stats.error, player::play_error::serialized_size_mismatch);
+	EXPECT_EQ(stats.streams, 0);
+	EXPECT_EQ(ecsact::test::fake_stream_count(), streams_before);
+}